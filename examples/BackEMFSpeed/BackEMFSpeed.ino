@@ -0,0 +1,106 @@
+/*
+ *  BackEMFSpeed.cpp
+ *  Example for driving with constant speed without encoders using CarBackEMFSpeedControl class.
+ *  The car drives 3 seconds forward with 200 mm/s, stops and then drives 3 seconds backward.
+ *
+ *  The back EMF of each motor is the difference of the voltages at its two terminals, while the motor driver output is released.
+ *  Each motor terminal is connected by a 1:2 voltage divider (e.g. 2 x 10 kOhm) to an analog input.
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of Arduino-RobotCar https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+/*
+ * You will need to change these values according to your motor, H-bridge and motor supply voltage.
+ * You must specify this before the include of "CarPWMMotorControl.hpp"
+ */
+//#define VIN_2_LI_ION                  // Activate this, if you use 2 Li-ion cells (around 7.4 volt) as motor supply.
+//#define VIN_1_LI_ION                  // If you use a mosfet bridge (TB6612), 1 Li-ion cell (around 3.7 volt) may be sufficient.
+//#define FULL_BRIDGE_INPUT_MILLIVOLT   6000  // Default. For 4 x AA batteries (6 volt).
+//#define USE_L298_BRIDGE            // Activate this, if you use a L298 bridge, which has higher losses than a recommended mosfet bridge like TB6612.
+//#define BACK_EMF_SETTLE_MICROS         500 // Default. Increase it, if the measured speed depends on the PWM too much.
+
+#include "CarPWMMotorControl.hpp"
+#include "CarBackEMFSpeedControl.hpp"
+
+#include "RobotCarPinDefinitionsAndMore.h"
+
+#define RIGHT_MOTOR_FORWARD_TERMINAL_PIN    A0
+#define RIGHT_MOTOR_BACKWARD_TERMINAL_PIN   A1
+#define LEFT_MOTOR_FORWARD_TERMINAL_PIN     A2
+#define LEFT_MOTOR_BACKWARD_TERMINAL_PIN    A3
+#define TERMINAL_VOLTAGE_DIVIDER_FACTOR      2
+#define ADC_REFERENCE_MILLIVOLT          5000L // VCC is used as reference
+
+#define SPEED_MILLIMETER_PER_SECOND        200
+#define DRIVE_MILLIS                      3000
+
+/*
+ * Is called by BackEMFSpeedControl.update() while the motor driver output is released
+ */
+uint16_t readBackEMFMillivolt(uint8_t aMotorIndex) {
+    int tADCDifference;
+    if (aMotorIndex == BACK_EMF_RIGHT_MOTOR_INDEX) {
+        tADCDifference = analogRead(RIGHT_MOTOR_FORWARD_TERMINAL_PIN) - analogRead(RIGHT_MOTOR_BACKWARD_TERMINAL_PIN);
+    } else {
+        tADCDifference = analogRead(LEFT_MOTOR_FORWARD_TERMINAL_PIN) - analogRead(LEFT_MOTOR_BACKWARD_TERMINAL_PIN);
+    }
+    if (tADCDifference < 0) {
+        tADCDifference = -tADCDifference; // Driving backward
+    }
+    return (tADCDifference * (ADC_REFERENCE_MILLIVOLT * TERMINAL_VOLTAGE_DIVIDER_FACTOR)) / 1024;
+}
+
+void setup() {
+    Serial.begin(115200);
+
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/ \
+    || defined(SERIALUSB_PID)  || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_PWMMOTORCONTROL));
+
+    RobotCar.init(RIGHT_MOTOR_FORWARD_PIN, RIGHT_MOTOR_BACKWARD_PIN, RIGHT_MOTOR_PWM_PIN, LEFT_MOTOR_FORWARD_PIN,
+    LEFT_MOTOR_BACKWARD_PIN, LEFT_MOTOR_PWM_PIN);
+    BackEMFSpeedControl.init(&readBackEMFMillivolt);
+
+    // Print info
+    PWMDcMotor::printCompileOptions(&Serial);
+
+    delay(5000);
+}
+
+void loop() {
+    static uint8_t sMotorDirection = DIRECTION_FORWARD;
+
+    BackEMFSpeedControl.setSpeedMillimeterPerSecond(SPEED_MILLIMETER_PER_SECOND, sMotorDirection);
+    uint32_t tStartMillis = millis();
+    while (millis() - tStartMillis < DRIVE_MILLIS) {
+        if (BackEMFSpeedControl.update()) {
+            BackEMFSpeedControl.printValues(&Serial);
+        }
+    }
+    BackEMFSpeedControl.stop();
+
+    sMotorDirection = oppositeDIRECTION(sMotorDirection);
+    delay(2000);
+}
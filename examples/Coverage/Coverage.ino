@@ -0,0 +1,106 @@
+/*
+ *  Coverage.cpp
+ *  Example for driving back and forth lanes over a rectangular area using CarCoveragePlanner class.
+ *  Obstacles in front of the car are detected by the HC-SR04 ultrasonic sensor and the car drives around them.
+ *  The coverage map is printed every 10 seconds.
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of Arduino-RobotCar https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+/*
+ * You will need to change these values according to your motor, H-bridge and motor supply voltage.
+ * You must specify this before the include of "CarPWMMotorControl.hpp"
+ */
+#define USE_ENCODER_MOTOR_CONTROL   // Required for CarOdometry. Use encoder interrupts attached at pin 2 and 3.
+//#define USE_ADAFRUIT_MOTOR_SHIELD   // Use Adafruit Motor Shield v2 connected by I2C instead of TB6612 or L298 breakout board.
+//#define USE_MPU6050_IMU             // Use GY-521 MPU6050 breakout board connected by I2C for a precise heading of the car. Connectors point to the rear.
+//#define VIN_2_LI_ION                  // Activate this, if you use 2 Li-ion cells (around 7.4 volt) as motor supply.
+//#define USE_L298_BRIDGE            // Activate this, if you use a L298 bridge, which has higher losses than a recommended mosfet bridge like TB6612.
+//#define COVERAGE_CELL_MILLIMETER      200 // Default. Should be around the width of the car.
+//#define COVERAGE_OBSTACLE_CENTIMETER   25 // Default. A forward distance below this value marks the cell in front of the car as blocked.
+
+#include "CarPWMMotorControl.hpp"
+#include "CarCoveragePlanner.hpp"
+
+#include "RobotCarPinDefinitionsAndMore.h"
+#include "HCSR04.hpp"
+
+#define NUMBER_OF_CELLS_X                   8 // 1.6 meter along the lanes
+#define NUMBER_OF_CELLS_Y                   6 // 6 lanes to the left of the start position
+#define DISTANCE_TIMEOUT_CENTIMETER       100
+#define DISTANCE_MEASUREMENT_PERIOD_MILLIS 50
+#define PRINT_COVERAGE_PERIOD_MILLIS    10000
+
+void setup() {
+    Serial.begin(115200);
+
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/ \
+    || defined(SERIALUSB_PID)  || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_PWMMOTORCONTROL));
+
+#if defined(USE_ADAFRUIT_MOTOR_SHIELD)
+    // For Adafruit Motor Shield v2
+    RobotCar.init();
+#else
+    RobotCar.init(RIGHT_MOTOR_FORWARD_PIN, RIGHT_MOTOR_BACKWARD_PIN, RIGHT_MOTOR_PWM_PIN, LEFT_MOTOR_FORWARD_PIN,
+    LEFT_MOTOR_BACKWARD_PIN, LEFT_MOTOR_PWM_PIN);
+#endif
+    initUSDistancePins(TRIGGER_OUT_PIN, ECHO_IN_PIN);
+
+    // Print info
+    PWMDcMotor::printCompileOptions(&Serial);
+
+    delay(5000);
+    CoveragePlanner.start(NUMBER_OF_CELLS_X, NUMBER_OF_CELLS_Y, DEFAULT_DRIVE_SPEED_PWM);
+}
+
+void loop() {
+    static uint8_t sForwardDistanceCentimeter = UINT8_MAX;
+    static uint32_t sLastDistanceMeasurementMillis;
+    static uint32_t sLastPrintMillis;
+
+    RobotCar.updateMotors();
+
+    if (millis() - sLastDistanceMeasurementMillis >= DISTANCE_MEASUREMENT_PERIOD_MILLIS) {
+        sLastDistanceMeasurementMillis = millis();
+        unsigned int tCentimeter = getUSDistanceAsCentimeterWithCentimeterTimeout(DISTANCE_TIMEOUT_CENTIMETER);
+        if (tCentimeter == DISTANCE_TIMEOUT_RESULT) {
+            tCentimeter = UINT8_MAX; // Nothing in range
+        }
+        sForwardDistanceCentimeter = tCentimeter;
+    }
+
+    bool tIsCovering = CoveragePlanner.update(sForwardDistanceCentimeter);
+    if (!tIsCovering || millis() - sLastPrintMillis >= PRINT_COVERAGE_PERIOD_MILLIS) {
+        sLastPrintMillis = millis();
+        CoveragePlanner.printCoverage(&Serial);
+    }
+    if (!tIsCovering) {
+        Serial.println(F("Coverage finished"));
+        while (true) {
+            ; // wait for reset
+        }
+    }
+}
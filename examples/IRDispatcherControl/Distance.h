@@ -143,7 +143,11 @@ extern uint8_t sDistanceSourceMode;
 #define INVALID_DEGREE   127 // To mark non valid DegreeOfDistanceGreaterThanThreshold or DegreeOf2ConsecutiveDistancesGreaterThanTwoThreshold in ForwardDistancesInfoStruct
 
 struct ForwardDistancesInfoStruct {
+#if defined(ENABLE_PIPELINED_SCAN)
+    uint8_t *RawDistancesArray; // Points to the last complete scan, the other buffer is filled by the running scan
+#else
     uint8_t RawDistancesArray[NUMBER_OF_DISTANCES]; // From 0 (right) to 180 degrees (left) with steps of 20 degrees
+#endif
     uint8_t ProcessedDistancesArray[NUMBER_OF_DISTANCES]; // From 0 (right) to 180 degrees (left) with steps of 20 degrees, invalid if ProcessedDistancesArray[0] == 0
     int8_t DegreeOfDistanceGreaterThanThreshold;
     int8_t DegreeOf2ConsecutiveDistancesGreaterThanTwoThreshold;
@@ -179,20 +183,187 @@ void playDistanceFeedbackTone(uint8_t aCentimeter);
 unsigned int getDistanceAsCentimeter(uint8_t aDistanceTimeoutCentimeter, bool aWaitForCurrentMeasurementToEnd = false,
         uint8_t aMinimumUSDistanceForMinimumMode = 0, bool aDoShow = true);
 
-#if defined(CAR_HAS_DISTANCE_SERVO)
+#if defined(ENABLE_ROTATION_SCAN)
+/*
+ * Scan by rotating the car in place for cars without distance servo. The forward sensor is sampled continuously
+ * and the samples are stored by IMU heading in sForwardDistancesInfo, so post processing is the same as for a servo scan.
+ */
+#  if !defined(USE_MPU6050_IMU)
+#error ENABLE_ROTATION_SCAN requires USE_MPU6050_IMU for the turn angle
+#  endif
+#  if !defined(CAR_HAS_DISTANCE_SERVO) && (defined(ENABLE_ADAPTIVE_SCAN) || defined(ENABLE_PIPELINED_SCAN))
+#error ENABLE_ADAPTIVE_SCAN and ENABLE_PIPELINED_SCAN require CAR_HAS_DISTANCE_SERVO
+#  endif
+#  if !defined(ROTATION_SCAN_DEGREES_PER_SECOND)
+#define ROTATION_SCAN_DEGREES_PER_SECOND    60 // 3 seconds for a scan. Gives around 30 samples per sector for 110 cm US timeout
+#  endif
+#define ROTATION_SCAN_START_DEGREES         (IndexToDegree(INDEX_RIGHT) - (DEGREES_PER_STEP / 2)) // -90, right border of first sector
+#define ROTATION_SCAN_SPEED_CONTROL_END_DEGREES 20 // Angular speed is not controlled in the last 20 degree, where updateMotors() reduces speed
+bool fillForwardDistancesInfoByRotation(bool aForceScan = false);
+#endif
+
+#if defined(CAR_HAS_DISTANCE_SERVO) || defined(ENABLE_ROTATION_SCAN)
 #define NO_TARGET_FOUND     360     // return value of scanForTargetAndPrint()
 int8_t scanForTargetAndPrint(uint8_t aMaximumTargetDistance);
 void printForwardDistanceInfo(Print *aSerial);
-unsigned int moveServoAndGetDistance(uint8_t aTargetDegrees, uint8_t aDistanceTimeoutCentimeter);
-void DistanceServoWriteAndWaitForStop(uint8_t aValue, bool doDelay = false);
 bool fillAndShowForwardDistancesInfo(bool aDoFirstValue, bool aForceScan = false);
 void doWallDetection();
 void postProcessDistances(uint8_t aDistanceThreshold);
 #define IndexToDegree(aIndex) (((aIndex * DEGREES_PER_STEP) + START_DEGREES) - 90) // generates smaller code than a function
 #endif
 
+#if defined(CAR_HAS_DISTANCE_SERVO)
+unsigned int moveServoAndGetDistance(uint8_t aTargetDegrees, uint8_t aDistanceTimeoutCentimeter);
+uint16_t getDistanceServoWaitMillis(uint8_t aDeltaDegrees);
+void DistanceServoWriteAndWaitForStop(uint8_t aValue, bool doDelay = false);
+#  if defined(ENABLE_TARGET_TRACKING)
+/*
+ * Target tracking for follower. The servo measures alternating left and right of the target bearing,
+ * and the bearing is moved to the side where the target was seen. The car steers by the bearing while driving.
+ */
+#define TARGET_TRACKING_DITHER_DEGREES          6 // Measurements are done at bearing +/- 6 degree
+#define TARGET_TRACKING_SEARCH_STEP_DEGREES    15 // If target is lost, it is searched with increasing offset around last bearing
+#define TARGET_TRACKING_MAX_LOST_STEPS          8 // Then search is restarted at last bearing
+#define TARGET_TRACKING_MAX_BEARING_DEGREES    70 // Servo range is 20 to 160 degree
+#define TARGET_TRACKING_STEERING_DEGREES       30 // Greater bearings are handled by rotation
+#  if !defined(TARGET_TRACKING_PWM_PER_DEGREE)
+#define TARGET_TRACKING_PWM_PER_DEGREE          2 // Speed difference of both motors for steering
+#  endif
+struct TargetTrackerStruct {
+    int8_t BearingDegrees;          // 0 is forward, positive is left
+    uint8_t Centimeter;             // Distance of target at last measurement, where it was seen
+    int16_t RangeRateCentimeterPerSecond; // Positive if target moves away
+    bool IsLocked;
+    uint8_t LostSteps;              // Number of measurements without target
+    int8_t DitherSign;              // Side of last measurement, 1 is left
+    uint8_t LastCentimeter;         // Distance of last measurement
+    unsigned long LastFoundMillis;
+};
+extern TargetTrackerStruct sTargetTracker;
+bool trackTarget(uint8_t aMaximumTargetDistance);
+void resetTargetTracking();
+int getTargetRangeRateSpeedPWM();
+void setSpeedPWMAndDirectionWithTargetBearing(uint8_t aRequestedSpeedPWM, uint8_t aRequestedDirection);
+#  endif
+#  if defined(ENABLE_ADAPTIVE_SCAN)
+/*
+ * Adaptive scan for fillAndShowForwardDistancesInfo(). Forward sectors, sectors with near obstacles and sectors at edges
+ * are measured at each scan, the other side sectors are skipped up to ADAPTIVE_SCAN_MAX_SKIPPED_SCANS times depending on speed.
+ */
+#    if !defined(ADAPTIVE_SCAN_FORWARD_DEGREES)
+#define ADAPTIVE_SCAN_FORWARD_DEGREES       30 // Sectors within +/- 30 degree are measured at each scan, these are 4 of 10 sectors
+#    endif
+#define ADAPTIVE_SCAN_EDGE_CENTIMETER       20 // Distance difference to a neighbor sector, which indicates an edge
+#define ADAPTIVE_SCAN_MAX_SKIPPED_SCANS      3 // Side sectors are skipped at most 3 times at full speed
+extern uint8_t sDistanceSkippedScansArray[NUMBER_OF_DISTANCES];
+bool isDistanceScanIndexDue(uint8_t aIndex);
+#  endif
+#  if defined(ENABLE_PIPELINED_SCAN)
+/*
+ * Double buffered scan. The scanner fills one buffer, while the planner uses sForwardDistancesInfo with the last complete scan.
+ * At the end of a scan both buffers are swapped by exchanging the pointers.
+ */
+extern uint8_t *sScanningDistancesArray;
+void swapForwardDistancesBuffers();
+bool updateForwardDistancesScan();
+#  endif
+#  if defined(ENABLE_WALL_FOLLOWING)
+/*
+ * Drive alongside a wall or in the middle of a corridor. The servo points at the side walls,
+ * and a PD controller steers by the offset to the target distance and by the wall angle,
+ * which is estimated from the change of the offset per driven distance.
+ */
+#define WALL_FOLLOW_MODE_RIGHT              0
+#define WALL_FOLLOW_MODE_LEFT               1
+#define WALL_FOLLOW_MODE_CORRIDOR           2 // Keep the middle between both walls
+#define WALL_FOLLOW_SERVO_DEGREES          10 // Measure at 10 and 170 degree to avoid measuring the own wheels
+#define WALL_FOLLOW_MIN_CENTIMETER         10 // Minimum target distance
+#define WALL_FOLLOW_MAX_CENTIMETER         60 // Greater distances are taken as no wall
+#define WALL_FOLLOW_FORWARD_CHECK_STEPS     4 // Forward distance is checked after each 4 side measurements
+#define WALL_FOLLOW_MIN_FORWARD_CENTIMETER 30 // Stop if obstacle ahead is nearer
+#define WALL_FOLLOW_MAX_ANGLE_DEGREES      45
+#  if !defined(WALL_FOLLOW_KP_PWM_PER_CENTIMETER)
+#define WALL_FOLLOW_KP_PWM_PER_CENTIMETER   3
+#  endif
+#  if !defined(WALL_FOLLOW_KD_PWM_PER_DEGREE)
+#define WALL_FOLLOW_KD_PWM_PER_DEGREE       2
+#  endif
+#define WALL_FOLLOW_MAX_STEERING_PWM       (DEFAULT_DRIVE_SPEED_PWM / 2)
+struct WallFollowerStruct {
+    uint8_t Mode;
+    uint8_t TargetCentimeter;       // Distance to wall. For corridor mode it is used if only one wall is found
+    uint8_t SpeedPWM;
+    uint8_t RightCentimeter;        // Last measured distances, WALL_FOLLOW_MAX_CENTIMETER if no wall
+    uint8_t LeftCentimeter;
+    int8_t OffsetCentimeter;        // Positive if car is too far left
+    int8_t WallAngleDegrees;        // Positive if car heads left, i.e. away from right wall
+    bool IsWallLost;
+    uint8_t StepCount;              // Selects the side to measure and the forward check
+    unsigned int LastDrivenCentimeter; // Driven distance at last offset computation
+#    if !defined(USE_ENCODER_MOTOR_CONTROL)
+    uint32_t DrivenMillimeter;      // Estimated from RequestedSpeedPWM and time
+    unsigned long MillisOfLastDrivenUpdate;
+#    endif
+};
+extern WallFollowerStruct sWallFollower;
+void startWallFollowing(uint8_t aSpeedPWM);
+bool doWallFollowingStep();
+#  endif
+#endif
+
 int doBuiltInCollisionAvoiding();
 
+#if defined(ENABLE_COLLISION_GUARD)
+/*
+ * Collision guard, which is called by getDistanceAsCentimeter() for each forward distance sample.
+ * It compares the forward distance with the distance required to stop, which is computed from braking distance
+ * and the closing speed for the reaction time.
+ */
+#  if !defined(COLLISION_GUARD_REACTION_MILLIS)
+#define COLLISION_GUARD_REACTION_MILLIS     100 // Time between measurement and start of braking, including the measurement itself
+#  endif
+#  if !defined(COLLISION_GUARD_MARGIN_CENTIMETER)
+#define COLLISION_GUARD_MARGIN_CENTIMETER     5 // Remaining distance to obstacle after stop
+#  endif
+#define COLLISION_GUARD_FORWARD_DEGREES      15 // Samples taken with a servo angle more than 15 degree from forward are not checked
+#define COLLISION_GUARD_MAX_SAMPLE_DISTANCE_MILLIS 500 // Closing speed is only computed from samples, which are not more apart
+#define COLLISION_GUARD_NONE                  0
+#define COLLISION_GUARD_SLOW_DOWN             1 // Distance is less than 2 times the required stopping distance
+#define COLLISION_GUARD_BRAKE                 2
+extern uint8_t sCollisionGuardLastAction;
+uint8_t checkForwardCollision(uint8_t aForwardCentimeter);
+#endif
+
+#if defined(USE_ENCODER_MOTOR_CONTROL)
+/*
+ * Calibration of MillimeterPerCountQ8 of the encoder motors by driving straight towards a wall.
+ * The driven distance is measured with the US distance sensor, which has a resolution of 0.2 mm.
+ */
+#define WALL_CALIBRATION_MIN_START_MILLIMETER   500 // Car must start at least 50 cm in front of a wall
+#define WALL_CALIBRATION_STOP_MILLIMETER        200 // Car stops around 20 cm in front of the wall
+#define WALL_CALIBRATION_NUMBER_OF_SAMPLES        8 // US samples averaged for each of the 2 distance measurements
+bool calibrateMillimeterPerCountAtWall();
+#endif
+
+#if defined(ENABLE_SPEED_GOVERNOR)
+/*
+ * Speed governor. Computes the maximum speed, at which the car can still stop in the free distance ahead,
+ * if the obstacle is detected one scan period plus sensor latency later.
+ */
+#  if !defined(SPEED_GOVERNOR_SENSOR_LATENCY_MILLIS)
+#define SPEED_GOVERNOR_SENSOR_LATENCY_MILLIS    50 // Measurement time of sensor and processing
+#  endif
+#  if !defined(SPEED_GOVERNOR_MARGIN_CENTIMETER)
+#define SPEED_GOVERNOR_MARGIN_CENTIMETER        10
+#  endif
+#  if !defined(SPEED_GOVERNOR_MAX_SPEED_PWM)
+#define SPEED_GOVERNOR_MAX_SPEED_PWM            MAX_SPEED_PWM
+#  endif
+#define SPEED_GOVERNOR_MAX_SCAN_PERIOD_MILLIS  1000 // Used for first call and for calls after a pause
+extern uint8_t sGovernedMaxSpeedPWM;
+uint8_t getGovernedMaxSpeedPWM(uint8_t aFreeCentimeter);
+#endif
+
 #if defined(CAR_HAS_IR_DISTANCE_SENSOR)
 #  if !defined(IR_SENSOR_TYPE_100550) && !defined(IR_SENSOR_TYPE_20150) && !defined(IR_SENSOR_TYPE_1080) && !defined(IR_SENSOR_TYPE_430)
 #define IR_SENSOR_TYPE_1080                    // default is 10 to 80 cm, GP2Y0A21YK0F
@@ -217,6 +388,31 @@ uint8_t getIRDistanceAsCentimeter(bool aWaitForCurrentMeasurementToEnd = false);
 extern VL53L1X sToFDistanceSensor;
 uint8_t getToFDistanceAsCentimeter();
 uint8_t readToFDistanceAsCentimeter(); // no start of measurement, just read result.
+
+#  if defined(TOF_USE_MULTI_ZONE)
+/*
+ * Multi zone mode. The 16 x 16 SPAD array is split into 4 SPAD wide zones, which look to the right, forward and left,
+ * and optionally 4 SPAD high zones, which look down and up. Each zone is measured by its own ROI (region of interest).
+ * Zone indexes 0 to 2 are the same as INDEX_TARGET_RIGHT, INDEX_TARGET_FORWARD and INDEX_TARGET_LEFT.
+ */
+#    if defined(TOF_MULTI_ZONE_WITH_UP_DOWN)
+#define TOF_NUMBER_OF_ZONES         5
+#define TOF_ZONE_INDEX_DOWN         3
+#define TOF_ZONE_INDEX_UP           4
+#    else
+#define TOF_NUMBER_OF_ZONES         3
+#    endif
+#define TOF_ZONE_DEGREES           10 // Zone centers are 6 of 16 SPADs apart, the field of view is 27 degree for 16 SPADs
+#define TOF_ZONE_TIMING_BUDGET_MILLIS 20 // Minimum for short distance mode, which gives 60 ms for 3 zones
+extern uint8_t sToFZoneDistancesCentimeter[TOF_NUMBER_OF_ZONES];
+extern uint8_t sToFCurrentZoneIndex;
+void setToFROIAndRestartRanging(uint8_t aCenterSPAD, uint8_t aROISize);
+void startToFZoneMeasurement(uint8_t aZoneIndex);
+bool updateToFZoneDistances();
+void getToFZoneDistances();
+void setToFFullROI();
+int8_t scanForTargetWithToFZones(uint8_t aMaximumTargetDistance);
+#  endif
 #endif
 
 #endif // _ROBOT_CAR_DISTANCE_H
@@ -257,6 +257,9 @@ bool readVINVoltage() {
      */
     sVINVoltage = tVINRawSum
             * ((VOLTAGE_DIVIDER_DIVISOR * (ADC_INTERNAL_REFERENCE_MILLIVOLT / 1000.0)) / (1023.0 * NUMBER_OF_VIN_SAMPLES));
+#endif
+#if defined(ENABLE_POWER_MANAGEMENT)
+    PowerManager.update(sVINVoltage * 1000); // Uses the current PWM values of the motors for estimation of battery sag
 #endif
     // resolution is about 5 mV and we display in a 10 mV resolution -> compare with (2 * NUMBER_OF_VIN_SAMPLES)
     if (abs(sLastVINRawSum - tVINRawSum) > (2 * NUMBER_OF_VIN_SAMPLES)) {
@@ -283,7 +286,8 @@ void readVINVoltageAndAdjustDriveSpeedAndPrint() {
     RobotCar.setDriveSpeedPWMFor2Volt(sVINVoltage);
     PWMDcMotor::MotorPWMHasChanged = true; // to force a new display of motor voltage
 
-    sprintf_P(sBDStringBuffer, PSTR("2 volt PWM %3d -> %3d"), tOldDriveSpeedPWM, RobotCar.rightCarMotor.DriveSpeedPWMFor2Volt);
+    char *tBufferEnd = formatInt(formatString_P(sBDStringBuffer, PSTR("2 volt PWM ")), tOldDriveSpeedPWM, 3);
+    formatInt(formatString_P(tBufferEnd, PSTR(" -> ")), RobotCar.rightCarMotor.DriveSpeedPWMFor2Volt, 3);
     BlueDisplay1.debug(sBDStringBuffer);
 #  else
     Serial.print(F("2 volt PWM: "));
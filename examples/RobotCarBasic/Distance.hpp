@@ -83,7 +83,13 @@ bool sEffectiveDistanceJustChanged;     // Is set and reset by getDistanceAsCent
 uint8_t sRawForwardDistancesArray[3];   // From 0 (70 degree, right) to 2 (110 degree, left) with steps of 20 degrees
 int8_t sComputedRotation;
 
+#if defined(ENABLE_PIPELINED_SCAN)
+uint8_t sDistancesBuffersArray[2][NUMBER_OF_DISTANCES];
+ForwardDistancesInfoStruct sForwardDistancesInfo = { sDistancesBuffersArray[0] };
+uint8_t *sScanningDistancesArray = sDistancesBuffersArray[1];
+#else
 ForwardDistancesInfoStruct sForwardDistancesInfo;
+#endif
 
 /*
  * This initializes the pins too
@@ -298,9 +304,239 @@ unsigned int getDistanceAsCentimeter(uint8_t aDistanceTimeoutCentimeter, bool aW
     } else {
         sEffectiveDistanceJustChanged = false;
     }
+#if defined(ENABLE_COLLISION_GUARD)
+    checkForwardCollision(tCentimeterToReturn);
+#endif
     return tCentimeterToReturn;
 }
 
+#if defined(USE_ENCODER_MOTOR_CONTROL)
+/*
+ * Uses US time of flight and not getDistanceAsCentimeter() to get millimeter resolution.
+ * @return Average of WALL_CALIBRATION_NUMBER_OF_SAMPLES US distances in millimeter, 0 if any measurement had a timeout
+ */
+static unsigned int getAveragedUSDistanceMillimeter() {
+    uint32_t tMicrosSum = 0;
+    for (uint_fast8_t i = 0; i < WALL_CALIBRATION_NUMBER_OF_SAMPLES; ++i) {
+        unsigned int tMicros = getUSDistance(US_DISTANCE_TIMEOUT_MICROS_FOR_2_METER);
+        if (tMicros == DISTANCE_TIMEOUT_RESULT) {
+            return 0;
+        }
+        tMicrosSum += tMicros;
+        delay(20); // Let the echoes of the last measurement fade away
+    }
+    return (tMicrosSum * 1000) / ((uint32_t) WALL_CALIBRATION_NUMBER_OF_SAMPLES * US_DISTANCE_TIMEOUT_MICROS_FOR_1_METER);
+}
+
+/*
+ * Car must face a wall at a distance between 50 cm and 2 meter.
+ * Drives straight to around 20 cm in front of the wall and computes MillimeterPerCountQ8 of each motor
+ * from the decrease of wall distance and the encoder counts of the motor.
+ * Values are not stored to EEPROM, use RobotCar.writeCarValuesToEeprom() for this.
+ * The reason of an abort is printed.
+ * @return true if aborted, i.e. no wall found, sensor timeout or result not plausible
+ */
+bool calibrateMillimeterPerCountAtWall() {
+#if defined(CAR_HAS_DISTANCE_SERVO)
+    DistanceServoWriteAndWaitForStop(90, true);
+#endif
+    unsigned int tStartMillimeter = getAveragedUSDistanceMillimeter();
+    if (tStartMillimeter == 0) {
+        Serial.println(F("No US echo, wall is farther than 200 cm or sensor failed"));
+        return true;
+    }
+    if (tStartMillimeter < WALL_CALIBRATION_MIN_START_MILLIMETER) {
+        Serial.println(F("Wall is nearer than 50 cm"));
+        return true;
+    }
+    RobotCar.goDistanceMillimeter(tStartMillimeter - WALL_CALIBRATION_STOP_MILLIMETER, DIRECTION_FORWARD);
+    delay(200); // Wait for the car to stand still, encoder counts of coasting are included
+    unsigned int tStopMillimeter = getAveragedUSDistanceMillimeter();
+    if (tStopMillimeter == 0) {
+        Serial.println(F("No US echo after driving"));
+        return true;
+    }
+    if (tStopMillimeter >= tStartMillimeter) {
+        Serial.println(F("Wall distance did not decrease"));
+        return true;
+    }
+    unsigned int tDrivenMillimeter = tStartMillimeter - tStopMillimeter;
+    unsigned int tRightEncoderCount = RobotCar.rightCarMotor.EncoderCount;
+    unsigned int tLeftEncoderCount = RobotCar.leftCarMotor.EncoderCount;
+    if (tRightEncoderCount == 0 || tLeftEncoderCount == 0) {
+        Serial.println(F("No encoder counts"));
+        return true;
+    }
+    RobotCar.rightCarMotor.setMillimeterPerCountQ8(((uint32_t) tDrivenMillimeter << 8) / tRightEncoderCount);
+    RobotCar.leftCarMotor.setMillimeterPerCountQ8(((uint32_t) tDrivenMillimeter << 8) / tLeftEncoderCount);
+
+    Serial.print(F("Driven "));
+    Serial.print(tDrivenMillimeter);
+    Serial.print(F(" mm, mm/count*256 right="));
+    Serial.print(RobotCar.rightCarMotor.MillimeterPerCountQ8);
+    Serial.print(F(" left="));
+    Serial.println(RobotCar.leftCarMotor.MillimeterPerCountQ8);
+    return false;
+}
+#endif // defined(USE_ENCODER_MOTOR_CONTROL)
+
+#if defined(ENABLE_COLLISION_GUARD)
+uint8_t sCollisionGuardLastAction;
+uint8_t sCollisionGuardLastCentimeter;
+unsigned long sCollisionGuardLastSampleMillis; // 0 if last sample was not forward
+uint8_t sCollisionGuardSpeedPWMBeforeSlowDown;  // 0 if speed was not reduced, otherwise it is restored if distance is clear again
+
+/*
+ * Speed of car in cm/s from encoder, IMU or estimated from PWM
+ */
+static unsigned int getCollisionGuardCarSpeed() {
+#  if defined(USE_ENCODER_MOTOR_CONTROL)
+    return RobotCar.rightCarMotor.getSpeed();
+#  elif defined(USE_MPU6050_IMU)
+    return RobotCar.CarSpeedCmPerSecondFromIMU;
+#  else
+    // MillisPerCentimeter is valid for DriveSpeedPWMFor2Volt
+    if (RobotCar.rightCarMotor.MillisPerCentimeter == 0 || RobotCar.rightCarMotor.DriveSpeedPWMFor2Volt == 0) {
+        return 0;
+    }
+    return (1000UL * RobotCar.rightCarMotor.CurrentCompensatedSpeedPWM)
+            / ((unsigned int) RobotCar.rightCarMotor.MillisPerCentimeter * RobotCar.rightCarMotor.DriveSpeedPWMFor2Volt);
+#  endif
+}
+
+/*
+ * Closing speed is the maximum of car speed and the speed computed from the last 2 forward samples,
+ * to handle obstacles which move towards the car.
+ * Stop distance = braking distance + distance driven at closing speed in reaction time + margin.
+ * If distance < stop distance, car is stopped with brake, if distance < 2 * stop distance, speed is reduced proportionally.
+ * @return COLLISION_GUARD_NONE, COLLISION_GUARD_SLOW_DOWN or COLLISION_GUARD_BRAKE
+ */
+uint8_t checkForwardCollision(uint8_t aForwardCentimeter) {
+    unsigned long tMillis = millis();
+#  if defined(CAR_HAS_DISTANCE_SERVO)
+    if (abs((int) sLastDistanceServoAngleInDegrees - 90) > COLLISION_GUARD_FORWARD_DEGREES) {
+        sCollisionGuardLastSampleMillis = 0;
+        return COLLISION_GUARD_NONE;
+    }
+#  endif
+#  if defined(USE_MPU6050_IMU)
+    if (RobotCar.CarRequestedRotationDegrees != 0) {
+        // Car is rotating, so the sensor does not look in driving direction
+        sCollisionGuardLastSampleMillis = 0;
+        return COLLISION_GUARD_NONE;
+    }
+#  endif
+    unsigned int tClosingSpeedCmPerSecond = getCollisionGuardCarSpeed();
+    if (sCollisionGuardLastSampleMillis != 0 && tMillis - sCollisionGuardLastSampleMillis < COLLISION_GUARD_MAX_SAMPLE_DISTANCE_MILLIS
+            && sCollisionGuardLastCentimeter > aForwardCentimeter) {
+        unsigned int tMeasuredSpeedCmPerSecond = ((uint32_t) (sCollisionGuardLastCentimeter - aForwardCentimeter) * 1000)
+                / (tMillis - sCollisionGuardLastSampleMillis + 1);
+        if (tClosingSpeedCmPerSecond < tMeasuredSpeedCmPerSecond) {
+            tClosingSpeedCmPerSecond = tMeasuredSpeedCmPerSecond;
+        }
+    }
+    sCollisionGuardLastCentimeter = aForwardCentimeter;
+    sCollisionGuardLastSampleMillis = tMillis;
+
+    uint8_t tAction = COLLISION_GUARD_NONE;
+    if (!RobotCar.isStopped() && RobotCar.getCarDirection() == DIRECTION_FORWARD) {
+#  if defined(USE_ENCODER_MOTOR_CONTROL) || defined(USE_MPU6050_IMU)
+        unsigned long tStopMillimeter = RobotCar.getBrakingDistanceMillimeter();
+#  else
+        unsigned int tCarSpeedCmPerSecond = getCollisionGuardCarSpeed();
+        unsigned long tStopMillimeter = ((unsigned long) tCarSpeedCmPerSecond * tCarSpeedCmPerSecond)
+                / (RAMP_DECELERATION_TIMES_2 / 100);
+#  endif
+        // cm/s * ms / 100 = mm
+        tStopMillimeter += ((unsigned long) tClosingSpeedCmPerSecond * COLLISION_GUARD_REACTION_MILLIS) / 100
+                + (COLLISION_GUARD_MARGIN_CENTIMETER * 10);
+        unsigned int tForwardMillimeter = aForwardCentimeter * 10;
+
+        if (tForwardMillimeter <= tStopMillimeter) {
+            RobotCar.stop(STOP_MODE_BRAKE);
+            tAction = COLLISION_GUARD_BRAKE;
+        } else if (tForwardMillimeter <= tStopMillimeter * 2) {
+            if (sCollisionGuardSpeedPWMBeforeSlowDown == 0) {
+                sCollisionGuardSpeedPWMBeforeSlowDown = RobotCar.rightCarMotor.RequestedSpeedPWM;
+            }
+            // Reduce speed proportional to the remaining distance between 1 and 2 times stop distance
+            uint8_t tSpeedPWM = ((unsigned long) sCollisionGuardSpeedPWMBeforeSlowDown * (tForwardMillimeter - tStopMillimeter))
+                    / tStopMillimeter;
+            if (tSpeedPWM < DEFAULT_START_SPEED_PWM) {
+                tSpeedPWM = DEFAULT_START_SPEED_PWM;
+            }
+            RobotCar.changeSpeedPWM(tSpeedPWM);
+            tAction = COLLISION_GUARD_SLOW_DOWN;
+        } else if (sCollisionGuardSpeedPWMBeforeSlowDown != 0) {
+            // Distance is clear again
+            RobotCar.changeSpeedPWM(sCollisionGuardSpeedPWMBeforeSlowDown);
+        }
+#  if defined(DEBUG)
+        if (tAction != COLLISION_GUARD_NONE) {
+            Serial.print(F("Collision guard distance="));
+            Serial.print(tForwardMillimeter);
+            Serial.print(F(" stop distance="));
+            Serial.print(tStopMillimeter);
+            Serial.print(F(" mm closing speed="));
+            Serial.print(tClosingSpeedCmPerSecond);
+            Serial.print(F(" cm/s action="));
+            Serial.println(tAction);
+        }
+#  endif
+    }
+    if (tAction != COLLISION_GUARD_SLOW_DOWN) {
+        sCollisionGuardSpeedPWMBeforeSlowDown = 0; // Speed was restored, or car was stopped or is not driving forward
+    }
+    sCollisionGuardLastAction = tAction;
+    return tAction;
+}
+#endif // defined(ENABLE_COLLISION_GUARD)
+
+#if defined(ENABLE_SPEED_GOVERNOR)
+uint8_t sGovernedMaxSpeedPWM;
+unsigned long sSpeedGovernorLastCallMillis;
+
+/*
+ * Call it once per scan or distance measurement, the time between 2 calls is taken as scan period.
+ * The stop distance for speed v in cm/s is v * (scan period + latency) / 100 + v * v / 40 (see getBrakingDistanceMillimeter()) in mm.
+ * Solving stop distance = free distance gives v = (sqrt(T * T + 1000 * D) - T) / 5 with T in ms and D in mm.
+ * Speed is converted to PWM by MillisPerCentimeter, which is valid for DriveSpeedPWMFor2Volt.
+ * @param aFreeCentimeter   Distance to next obstacle ahead
+ * @return Maximum SpeedPWM, 0 if free distance is less than margin
+ */
+uint8_t getGovernedMaxSpeedPWM(uint8_t aFreeCentimeter) {
+    unsigned long tMillis = millis();
+    unsigned long tScanPeriodMillis = tMillis - sSpeedGovernorLastCallMillis;
+    sSpeedGovernorLastCallMillis = tMillis;
+    if (tScanPeriodMillis > SPEED_GOVERNOR_MAX_SCAN_PERIOD_MILLIS) {
+        tScanPeriodMillis = SPEED_GOVERNOR_MAX_SCAN_PERIOD_MILLIS;
+    }
+
+    uint8_t tSpeedPWM = 0;
+    if (aFreeCentimeter > SPEED_GOVERNOR_MARGIN_CENTIMETER) {
+        uint32_t tFreeMillimeter = (aFreeCentimeter - SPEED_GOVERNOR_MARGIN_CENTIMETER) * 10;
+        uint32_t tReactionMillis = tScanPeriodMillis + SPEED_GOVERNOR_SENSOR_LATENCY_MILLIS;
+        unsigned int tSpeedCmPerSecond = (sqrt((tReactionMillis * tReactionMillis) + (1000 * tFreeMillimeter)) - tReactionMillis) / 5;
+
+#  if defined(USE_ENCODER_MOTOR_CONTROL)
+        uint8_t tMillisPerCentimeter = DEFAULT_MILLIS_PER_CENTIMETER;
+#  else
+        uint8_t tMillisPerCentimeter = RobotCar.rightCarMotor.MillisPerCentimeter;
+#  endif
+        uint32_t tSpeedPWM32 = ((uint32_t) tSpeedCmPerSecond * tMillisPerCentimeter * RobotCar.rightCarMotor.DriveSpeedPWMFor2Volt)
+                / 1000;
+        if (tSpeedPWM32 > SPEED_GOVERNOR_MAX_SPEED_PWM) {
+            tSpeedPWM32 = SPEED_GOVERNOR_MAX_SPEED_PWM;
+        } else if (tSpeedPWM32 < DEFAULT_START_SPEED_PWM) {
+            tSpeedPWM32 = DEFAULT_START_SPEED_PWM; // Lower speeds do not move the car
+        }
+        tSpeedPWM = tSpeedPWM32;
+    }
+    sGovernedMaxSpeedPWM = tSpeedPWM;
+    return tSpeedPWM;
+}
+#endif // defined(ENABLE_SPEED_GOVERNOR)
+
 #if defined(CAR_HAS_IR_DISTANCE_SENSOR)
 #if !defined(DISTANCE_TIMEOUT_RESULT)
 #define DISTANCE_TIMEOUT_RESULT                   0
@@ -419,6 +655,149 @@ uint8_t getToFDistanceAsCentimeter() {
     return readToFDistanceAsCentimeter();
 }
 
+#  if defined(TOF_USE_MULTI_ZONE)
+/*
+ * SPAD number of column x and row y is 128 + (x * 8) + (15 - y) for y > 7, else ((15 - x) * 8) + y.
+ * Zone centers are columns 2, 8 and 14 of row 8, and rows 2 and 14 of column 8.
+ * Right and left depend on the mounting of the sensor, define TOF_ZONES_MIRRORED if they are swapped.
+ */
+const uint8_t sToFZoneCenterSPADArray[TOF_NUMBER_OF_ZONES] PROGMEM = {
+#    if defined(TOF_ZONES_MIRRORED)
+        247, 199, 151
+#    else
+        151, 199, 247
+#    endif
+#    if defined(TOF_MULTI_ZONE_WITH_UP_DOWN)
+        , 58, 193
+#    endif
+        };
+#define TOF_ROI_SIZE_4_X_16     (((16 - 1) << 4) | (4 - 1)) // Register value is (height - 1) << 4 | (width - 1)
+#define TOF_ROI_SIZE_16_X_4     (((4 - 1) << 4) | (16 - 1))
+#define TOF_ROI_SIZE_16_X_16    0xFF
+#define TOF_FULL_ROI_CENTER_SPAD 199
+
+uint8_t sToFZoneDistancesCentimeter[TOF_NUMBER_OF_ZONES];
+uint8_t sToFCurrentZoneIndex;
+
+/*
+ * Set ROI of zone and start measurement.
+ * We write the registers directly, since VL53L1X_SetROI() does not accept another center for ROIs higher than 10.
+ */
+/*
+ * The ROI must not be changed while ranging. The interrupt is cleared to discard a result of the previous ROI,
+ * which may be ready at this time.
+ */
+void setToFROIAndRestartRanging(uint8_t aCenterSPAD, uint8_t aROISize) {
+    sToFDistanceSensor.VL53L1X_StopRanging();
+    sToFDistanceSensor.VL53L1_WrByte(sToFDistanceSensor.Device, ROI_CONFIG__USER_ROI_CENTRE_SPAD, aCenterSPAD);
+    sToFDistanceSensor.VL53L1_WrByte(sToFDistanceSensor.Device, ROI_CONFIG__USER_ROI_REQUESTED_GLOBAL_XY_SIZE, aROISize);
+    sToFDistanceSensor.VL53L1X_ClearInterrupt();
+    sToFDistanceSensor.VL53L1X_StartRanging();
+}
+
+void startToFZoneMeasurement(uint8_t aZoneIndex) {
+    sToFCurrentZoneIndex = aZoneIndex;
+    uint8_t tROISize = TOF_ROI_SIZE_4_X_16;
+#    if defined(TOF_MULTI_ZONE_WITH_UP_DOWN)
+    if (aZoneIndex >= TOF_ZONE_INDEX_DOWN) {
+        tROISize = TOF_ROI_SIZE_16_X_4;
+    }
+#    endif
+    setToFROIAndRestartRanging(pgm_read_byte(&sToFZoneCenterSPADArray[aZoneIndex]), tROISize);
+}
+
+/*
+ * Restore the full field of view for getDistanceAsCentimeter()
+ */
+void setToFFullROI() {
+    setToFROIAndRestartRanging(TOF_FULL_ROI_CENTER_SPAD, TOF_ROI_SIZE_16_X_16);
+}
+
+/*
+ * Non blocking. Start the cycle with startToFZoneMeasurement(0) and call it in loop.
+ * If data of current zone is ready, store it and start measurement of next zone.
+ * Do not call getDistanceAsCentimeter() in between, since it would use the ROI of the current zone.
+ * @return true if distances of all zones were updated
+ */
+bool updateToFZoneDistances() {
+    uint8_t tDataReady;
+    sToFDistanceSensor.VL53L1_RdByte(sToFDistanceSensor.Device, GPIO__TIO_HV_STATUS, &tDataReady);
+    if (!(tDataReady & 1)) {
+        return false;
+    }
+    sToFZoneDistancesCentimeter[sToFCurrentZoneIndex] = readToFDistanceAsCentimeter(); // returns immediately, since data is ready
+    uint8_t tNextZoneIndex = sToFCurrentZoneIndex + 1;
+    if (tNextZoneIndex >= TOF_NUMBER_OF_ZONES) {
+        tNextZoneIndex = 0;
+    }
+    startToFZoneMeasurement(tNextZoneIndex);
+    return (tNextZoneIndex == 0);
+}
+
+/*
+ * Blocking. Measure all zones once, takes TOF_NUMBER_OF_ZONES * TOF_ZONE_TIMING_BUDGET_MILLIS,
+ * then restore full ROI and timing budget for getDistanceAsCentimeter()
+ */
+void getToFZoneDistances() {
+    sToFDistanceSensor.VL53L1X_StopRanging(); // Timing budget must not be changed while ranging
+    sToFDistanceSensor.VL53L1X_SetTimingBudgetInMs(TOF_ZONE_TIMING_BUDGET_MILLIS);
+    for (uint_fast8_t i = 0; i < TOF_NUMBER_OF_ZONES; ++i) {
+        startToFZoneMeasurement(i);
+        sToFZoneDistancesCentimeter[i] = readToFDistanceAsCentimeter();
+    }
+    sToFDistanceSensor.VL53L1X_StopRanging();
+    sToFDistanceSensor.VL53L1X_SetTimingBudgetInMs(33);
+    setToFFullROI();
+}
+
+/*
+ * Replacement of scanForTargetAndPrint() without servo movement.
+ * Fills sRawForwardDistancesArray with the distances of the right, forward and left zone.
+ * @return rotation degree to target, 0 if target is forward or not found
+ */
+int8_t scanForTargetWithToFZones(uint8_t aMaximumTargetDistance) {
+    getToFZoneDistances();
+
+    uint8_t tMinDistance = 0xFF;
+    int8_t tRotationDegree = 0;
+    for (uint_fast8_t i = INDEX_TARGET_RIGHT; i <= INDEX_TARGET_LEFT; ++i) {
+        uint8_t tCentimeter = sToFZoneDistancesCentimeter[i];
+        if (tCentimeter > FOLLOWER_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER) {
+            tCentimeter = FOLLOWER_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER;
+        }
+        sRawForwardDistancesArray[i] = tCentimeter;
+        if (tMinDistance > tCentimeter) {
+            tMinDistance = tCentimeter;
+            tRotationDegree = ((int8_t) i - INDEX_TARGET_FORWARD) * TOF_ZONE_DEGREES;
+        }
+    }
+
+    if (sRawForwardDistancesArray[INDEX_TARGET_FORWARD] <= aMaximumTargetDistance) {
+        // target found in forward direction
+        tRotationDegree = 0;
+        sEffectiveDistanceJustChanged = true; // force movement
+    }
+    if (tMinDistance > aMaximumTargetDistance) {
+        // Target not found at any zone
+        tRotationDegree = 0;
+    }
+
+#    if !defined(USE_BLUE_DISPLAY_GUI)
+    Serial.print(F("ToF zones: "));
+    for (uint_fast8_t i = 0; i < TOF_NUMBER_OF_ZONES; ++i) {
+        Serial.print(sToFZoneDistancesCentimeter[i]);
+        Serial.print(' ');
+    }
+    Serial.print(F("-> "));
+    Serial.print(tRotationDegree);
+    Serial.print(F(" degree "));
+#    endif
+
+    sComputedRotation = tRotationDegree;
+    return tRotationDegree;
+}
+#  endif // defined(TOF_USE_MULTI_ZONE)
+
 #endif // CAR_HAS_TOF_DISTANCE_SENSOR
 
 #if defined(CAR_HAS_DISTANCE_SERVO)
@@ -431,6 +810,31 @@ unsigned int moveServoAndGetDistance(uint8_t aTargetDegrees, uint8_t aDistanceTi
 }
 
 //#define USE_OVERSHOOT_FOR_FAST_SERVO_MOVING
+/*
+ * @return Time for the servo to move aDeltaDegrees and to settle for a stable distance measurement
+ */
+uint16_t getDistanceServoWaitMillis(uint8_t aDeltaDegrees) {
+    /*
+     * Factor 8 gives a fairly reproducible US result, but some dropouts for IR
+     * factor 7 gives some strange (to small) values for US.
+     */
+    uint16_t tWaitDelayforServo;
+    if (sDoSlowScan) {
+        tWaitDelayforServo = aDeltaDegrees * 16; // 16 => 288 ms for 18 degrees
+    } else {
+#if defined(USE_OVERSHOOT_FOR_FAST_SERVO_MOVING)
+        tWaitDelayforServo = aDeltaDegrees * 5;
+#else
+#  if defined(CAR_HAS_IR_DISTANCE_SENSOR)  // TODO really required?
+        tWaitDelayforServo = aDeltaDegrees * 9; // 9 => 162 ms for 18 degrees
+#  else
+        tWaitDelayforServo = aDeltaDegrees * 8; // 7 => 128|140 ms, 8 => 144|160 for 18|20 degrees
+#  endif
+#endif
+    }
+    return tWaitDelayforServo;
+}
+
 /**
  * Handles overflow, no movement
  * servo trim value, servo mounted head down, and then does a Servo.write().
@@ -511,24 +915,7 @@ void DistanceServoWriteAndWaitForStop(uint8_t aTargetDegrees, bool doWaitForStop
 //        delay(SERVO_INITIAL_DELAY);
 //        digitalWrite(DEBUG_OUT_PIN, LOW);
 
-        /*
-         * Factor 8 gives a fairly reproducible US result, but some dropouts for IR
-         * factor 7 gives some strange (to small) values for US.
-         */
-        uint16_t tWaitDelayforServo;
-        if (sDoSlowScan) {
-            tWaitDelayforServo = tDeltaDegrees * 16; // 16 => 288 ms for 18 degrees
-        } else {
-#if defined(USE_OVERSHOOT_FOR_FAST_SERVO_MOVING)
-            tWaitDelayforServo = tDeltaDegrees * 5;
-#else
-#  if defined(CAR_HAS_IR_DISTANCE_SENSOR)  // TODO really required?
-            tWaitDelayforServo = tDeltaDegrees * 9; // 9 => 162 ms for 18 degrees
-#  else
-            tWaitDelayforServo = tDeltaDegrees * 8; // 7 => 128|140 ms, 8 => 144|160 for 18|20 degrees
-#  endif
-#endif
-        }
+        uint16_t tWaitDelayforServo = getDistanceServoWaitMillis(tDeltaDegrees);
 #if defined(USE_BLUE_DISPLAY_GUI)
         delayAndLoopGUI(tWaitDelayforServo);
 #else
@@ -673,7 +1060,9 @@ int8_t scanForTargetAndPrint(uint8_t aMaximumTargetDistance) {
      * Print results
      */
 #if defined(USE_BLUE_DISPLAY_GUI)
-    sprintf_P(sBDStringBuffer, PSTR("rotation:%3d\xB0 distance:%3dcm"), tRotationDegree, tMinDistance); // \xB0 is degree character
+    char *tBufferEnd = formatInt(formatString_P(sBDStringBuffer, PSTR("rotation:")), tRotationDegree, 3);
+    tBufferEnd = formatInt(formatString_P(tBufferEnd, PSTR("\xB0 distance:")), tMinDistance, 3); // \xB0 is degree character
+    formatString_P(tBufferEnd, PSTR("cm"));
     BlueDisplay1.drawText(BUTTON_WIDTH_3_5_POS_2, US_DISTANCE_MAP_ORIGIN_Y + TEXT_SIZE_11, sBDStringBuffer, TEXT_SIZE_11,
             COLOR16_BLACK, COLOR16_WHITE);
 #else
@@ -687,6 +1076,376 @@ int8_t scanForTargetAndPrint(uint8_t aMaximumTargetDistance) {
     return tRotationDegree;
 }
 
+#if defined(ENABLE_TARGET_TRACKING)
+TargetTrackerStruct sTargetTracker;
+
+/*
+ * Forget target but keep bearing to start next search there. Call it after a rotation, with the rotated degrees subtracted from bearing.
+ */
+void resetTargetTracking() {
+    sTargetTracker.IsLocked = false;
+    sTargetTracker.LostSteps = 1;
+    sTargetTracker.RangeRateCentimeterPerSecond = 0;
+}
+
+/*
+ * Does one measurement at the bearing of the target plus an offset, which alternates between left and right.
+ * If target is locked the offset is TARGET_TRACKING_DITHER_DEGREES,
+ * if target was lost, it increases with each measurement, starting at the last known bearing.
+ * If target is seen only at one side, the bearing is moved half the way to this side,
+ * if it is seen at both sides, bearing is moved 1 degree to the side with the smaller distance.
+ * @return true if target is locked, then sTargetTracker.Centimeter and BearingDegrees are valid
+ */
+bool trackTarget(uint8_t aMaximumTargetDistance) {
+    int8_t tOffsetDegrees = TARGET_TRACKING_DITHER_DEGREES;
+    if (sTargetTracker.LostSteps > 1) {
+        tOffsetDegrees = (sTargetTracker.LostSteps / 2) * TARGET_TRACKING_SEARCH_STEP_DEGREES;
+    }
+    sTargetTracker.DitherSign = (sTargetTracker.DitherSign > 0) ? -1 : 1;
+    int tDegrees = sTargetTracker.BearingDegrees + (sTargetTracker.DitherSign * tOffsetDegrees);
+    if (tDegrees > TARGET_TRACKING_MAX_BEARING_DEGREES) {
+        tDegrees = TARGET_TRACKING_MAX_BEARING_DEGREES;
+    } else if (tDegrees < -TARGET_TRACKING_MAX_BEARING_DEGREES) {
+        tDegrees = -TARGET_TRACKING_MAX_BEARING_DEGREES;
+    }
+
+    uint8_t tCentimeter = moveServoAndGetDistance(90 + tDegrees, FOLLOWER_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER);
+    if (tCentimeter == DISTANCE_TIMEOUT_RESULT) {
+        tCentimeter = FOLLOWER_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER;
+    }
+
+    if (tCentimeter <= aMaximumTargetDistance) {
+        if (sTargetTracker.LostSteps > 1) {
+            // Found while searching
+            sTargetTracker.BearingDegrees = tDegrees;
+        } else if (sTargetTracker.LastCentimeter > aMaximumTargetDistance) {
+            // Seen only at this side
+            sTargetTracker.BearingDegrees += (tDegrees - sTargetTracker.BearingDegrees) / 2;
+        } else if (tCentimeter + 2 < sTargetTracker.LastCentimeter) {
+            sTargetTracker.BearingDegrees += sTargetTracker.DitherSign;
+        } else if (tCentimeter > sTargetTracker.LastCentimeter + 2) {
+            sTargetTracker.BearingDegrees -= sTargetTracker.DitherSign;
+        }
+
+        unsigned long tMillis = millis();
+        if (sTargetTracker.IsLocked) {
+            // long, since 1000 * difference overflows int above 32 cm, and the time difference can exceed 32 seconds
+            long tRangeRate = ((long) ((int) tCentimeter - (int) sTargetTracker.Centimeter) * 1000)
+                    / (long) (tMillis - sTargetTracker.LastFoundMillis + 1);
+            tRangeRate = constrain(tRangeRate, -1000L, 1000L); // +/- 10 m/s is much more than the car can follow
+            // Low pass of 1/4
+            sTargetTracker.RangeRateCentimeterPerSecond = ((sTargetTracker.RangeRateCentimeterPerSecond * 3) + tRangeRate) / 4;
+        }
+        sTargetTracker.Centimeter = tCentimeter;
+        sTargetTracker.LastFoundMillis = tMillis;
+        sTargetTracker.IsLocked = true;
+        sTargetTracker.LostSteps = 0;
+
+    } else if (sTargetTracker.LostSteps > 0 || sTargetTracker.LastCentimeter > aMaximumTargetDistance) {
+        /*
+         * Not seen at both sides
+         */
+        sTargetTracker.IsLocked = false;
+        sTargetTracker.LostSteps++;
+        if (sTargetTracker.LostSteps > TARGET_TRACKING_MAX_LOST_STEPS) {
+            sTargetTracker.LostSteps = 1; // Restart search at last bearing
+        }
+    }
+    sTargetTracker.LastCentimeter = tCentimeter;
+    return sTargetTracker.IsLocked;
+}
+
+/*
+ * Converts the range rate of the target to a SpeedPWM, which can be added to the speed computed from the distance.
+ * DEFAULT_MILLIS_PER_CENTIMETER is valid for DEFAULT_DRIVE_SPEED_PWM.
+ */
+int getTargetRangeRateSpeedPWM() {
+    return ((long) sTargetTracker.RangeRateCentimeterPerSecond * DEFAULT_MILLIS_PER_CENTIMETER * DEFAULT_DRIVE_SPEED_PWM) / 1000;
+}
+
+/*
+ * Forward: the motor at the side of the target runs slower, to turn towards the target while driving.
+ */
+void setSpeedPWMAndDirectionWithTargetBearing(uint8_t aRequestedSpeedPWM, uint8_t aRequestedDirection) {
+    int tSteeringSpeedPWM = 0;
+    if (aRequestedDirection == DIRECTION_FORWARD && sTargetTracker.IsLocked) {
+        tSteeringSpeedPWM = sTargetTracker.BearingDegrees * TARGET_TRACKING_PWM_PER_DEGREE;
+    }
+    if (tSteeringSpeedPWM == 0) {
+#  if defined(ENABLE_SMOOTH_SPEED_CHANGE)
+        RobotCar.setSpeedPWMAndDirectionSmooth(
+                (aRequestedDirection == DIRECTION_BACKWARD) ? -(int) aRequestedSpeedPWM : (int) aRequestedSpeedPWM);
+#  else
+        RobotCar.setSpeedPWMAndDirection(aRequestedSpeedPWM, aRequestedDirection);
+#  endif
+        return;
+    }
+    int tRightSpeedPWM = constrain(aRequestedSpeedPWM + tSteeringSpeedPWM, 0, MAX_SPEED_PWM);
+    int tLeftSpeedPWM = constrain(aRequestedSpeedPWM - tSteeringSpeedPWM, 0, MAX_SPEED_PWM);
+#  if defined(ENABLE_SMOOTH_SPEED_CHANGE)
+    RobotCar.setSpeedPWMSmooth(tLeftSpeedPWM, tRightSpeedPWM); // Blending handles the change from backward
+#  else
+    RobotCar.checkAndHandleDirectionChange(DIRECTION_FORWARD);
+    RobotCar.setSpeedPWM(tLeftSpeedPWM, tRightSpeedPWM); // for mecanum car, this disables following of the right motor
+#  endif
+}
+#endif // defined(ENABLE_TARGET_TRACKING)
+
+#if defined(ENABLE_WALL_FOLLOWING)
+WallFollowerStruct sWallFollower;
+
+static unsigned int getWallFollowingDrivenCentimeter() {
+#  if defined(USE_ENCODER_MOTOR_CONTROL)
+    return RobotCar.rightCarMotor.getDistanceCentimeter();
+#  else
+    // MillisPerCentimeter is valid for DriveSpeedPWMFor2Volt, so scale by current speed
+    unsigned long tMillis = millis();
+    sWallFollower.DrivenMillimeter += RobotCar.rightCarMotor.convertMillisToMillimeter(RobotCar.rightCarMotor.RequestedSpeedPWM,
+            tMillis - sWallFollower.MillisOfLastDrivenUpdate);
+    sWallFollower.MillisOfLastDrivenUpdate = tMillis;
+    return sWallFollower.DrivenMillimeter / MILLIMETER_IN_ONE_CENTIMETER;
+#  endif
+}
+
+static uint8_t getWallDistance(uint8_t aServoDegrees) {
+    uint8_t tCentimeter = moveServoAndGetDistance(aServoDegrees, WALL_FOLLOW_MAX_CENTIMETER);
+    if (tCentimeter == DISTANCE_TIMEOUT_RESULT || tCentimeter > WALL_FOLLOW_MAX_CENTIMETER) {
+        tCentimeter = WALL_FOLLOW_MAX_CENTIMETER;
+    }
+    return tCentimeter;
+}
+
+/*
+ * Measures both sides and chooses the mode. If both walls are found, the middle of the corridor is kept,
+ * otherwise the current distance to the found wall is kept.
+ * If no wall is found, the right wall is searched with WALL_FOLLOW_MAX_CENTIMETER / 2 as target distance.
+ */
+void startWallFollowing(uint8_t aSpeedPWM) {
+    sWallFollower.SpeedPWM = aSpeedPWM;
+    sWallFollower.RightCentimeter = getWallDistance(WALL_FOLLOW_SERVO_DEGREES);
+    sWallFollower.LeftCentimeter = getWallDistance(180 - WALL_FOLLOW_SERVO_DEGREES);
+    bool tRightWallFound = sWallFollower.RightCentimeter < WALL_FOLLOW_MAX_CENTIMETER;
+    bool tLeftWallFound = sWallFollower.LeftCentimeter < WALL_FOLLOW_MAX_CENTIMETER;
+
+    uint8_t tTargetCentimeter;
+    if (tRightWallFound && tLeftWallFound) {
+        sWallFollower.Mode = WALL_FOLLOW_MODE_CORRIDOR;
+        tTargetCentimeter = (sWallFollower.RightCentimeter + sWallFollower.LeftCentimeter) / 2;
+    } else if (tLeftWallFound) {
+        sWallFollower.Mode = WALL_FOLLOW_MODE_LEFT;
+        tTargetCentimeter = sWallFollower.LeftCentimeter;
+    } else {
+        sWallFollower.Mode = WALL_FOLLOW_MODE_RIGHT;
+        tTargetCentimeter = sWallFollower.RightCentimeter;
+        if (!tRightWallFound) {
+            tTargetCentimeter = WALL_FOLLOW_MAX_CENTIMETER / 2;
+        }
+    }
+    if (tTargetCentimeter < WALL_FOLLOW_MIN_CENTIMETER) {
+        tTargetCentimeter = WALL_FOLLOW_MIN_CENTIMETER;
+    }
+    sWallFollower.TargetCentimeter = tTargetCentimeter;
+    sWallFollower.OffsetCentimeter = 0;
+    sWallFollower.WallAngleDegrees = 0;
+    sWallFollower.IsWallLost = false;
+    sWallFollower.StepCount = 0;
+#  if !defined(USE_ENCODER_MOTOR_CONTROL)
+    sWallFollower.DrivenMillimeter = 0;
+    sWallFollower.MillisOfLastDrivenUpdate = millis();
+#  endif
+    sWallFollower.LastDrivenCentimeter = getWallFollowingDrivenCentimeter();
+#  if defined(DEBUG)
+    Serial.print(F("Wall following mode="));
+    Serial.print(sWallFollower.Mode);
+    Serial.print(F(" target="));
+    Serial.print(tTargetCentimeter);
+    Serial.println(F(" cm"));
+#  endif
+    RobotCar.setSpeedPWMAndDirection(aSpeedPWM, DIRECTION_FORWARD);
+}
+
+/*
+ * Does one measurement and sets motor speeds. Call it in loop.
+ * Every WALL_FOLLOW_FORWARD_CHECK_STEPS + 1 step, the forward distance is measured instead of a side distance.
+ * If a needed wall is lost, the car drives straight ahead.
+ * @return false if car was stopped because of an obstacle ahead.
+ */
+bool doWallFollowingStep() {
+    sWallFollower.StepCount++;
+    if (sWallFollower.StepCount > WALL_FOLLOW_FORWARD_CHECK_STEPS) {
+        sWallFollower.StepCount = 0;
+        unsigned int tForwardCentimeter = moveServoAndGetDistance(90, WALL_FOLLOW_MAX_CENTIMETER);
+        if (tForwardCentimeter != DISTANCE_TIMEOUT_RESULT && tForwardCentimeter < WALL_FOLLOW_MIN_FORWARD_CENTIMETER) {
+            RobotCar.stop(STOP_MODE_BRAKE);
+            return false;
+        }
+        return true;
+    }
+
+    /*
+     * Measure one side. In corridor mode sides are alternated.
+     */
+    if (sWallFollower.Mode == WALL_FOLLOW_MODE_RIGHT
+            || (sWallFollower.Mode == WALL_FOLLOW_MODE_CORRIDOR && (sWallFollower.StepCount & 0x01))) {
+        sWallFollower.RightCentimeter = getWallDistance(WALL_FOLLOW_SERVO_DEGREES);
+    } else {
+        sWallFollower.LeftCentimeter = getWallDistance(180 - WALL_FOLLOW_SERVO_DEGREES);
+    }
+    bool tRightWallFound = sWallFollower.RightCentimeter < WALL_FOLLOW_MAX_CENTIMETER;
+    bool tLeftWallFound = sWallFollower.LeftCentimeter < WALL_FOLLOW_MAX_CENTIMETER;
+
+    /*
+     * Compute offset, positive if car is too far left. In corridor mode, a single wall is followed with TargetCentimeter.
+     */
+    int tOffsetCentimeter;
+    if (sWallFollower.Mode == WALL_FOLLOW_MODE_CORRIDOR && tRightWallFound && tLeftWallFound) {
+        tOffsetCentimeter = ((int) sWallFollower.RightCentimeter - (int) sWallFollower.LeftCentimeter) / 2;
+    } else if (sWallFollower.Mode != WALL_FOLLOW_MODE_LEFT && tRightWallFound) {
+        tOffsetCentimeter = (int) sWallFollower.RightCentimeter - (int) sWallFollower.TargetCentimeter;
+    } else if (sWallFollower.Mode != WALL_FOLLOW_MODE_RIGHT && tLeftWallFound) {
+        tOffsetCentimeter = (int) sWallFollower.TargetCentimeter - (int) sWallFollower.LeftCentimeter;
+    } else {
+        // No wall here, drive straight ahead
+        sWallFollower.IsWallLost = true;
+        sWallFollower.WallAngleDegrees = 0;
+        RobotCar.setSpeedPWMAndDirection(sWallFollower.SpeedPWM, DIRECTION_FORWARD);
+        return true;
+    }
+
+    /*
+     * Estimate wall angle from the change of the offset since last computation. For small angles sine is angle in radian.
+     */
+    unsigned int tDrivenCentimeter = getWallFollowingDrivenCentimeter();
+    unsigned int tDeltaCentimeter = tDrivenCentimeter - sWallFollower.LastDrivenCentimeter;
+    if (sWallFollower.IsWallLost) {
+        // No valid last offset
+        sWallFollower.IsWallLost = false;
+        sWallFollower.LastDrivenCentimeter = tDrivenCentimeter;
+    } else if (tDeltaCentimeter >= 2) {
+        int tWallAngleDegrees = ((tOffsetCentimeter - sWallFollower.OffsetCentimeter) * (int) RAD_TO_DEG) / (int) tDeltaCentimeter;
+        sWallFollower.WallAngleDegrees = constrain(tWallAngleDegrees, -WALL_FOLLOW_MAX_ANGLE_DEGREES, WALL_FOLLOW_MAX_ANGLE_DEGREES);
+        sWallFollower.LastDrivenCentimeter = tDrivenCentimeter;
+    }
+    sWallFollower.OffsetCentimeter = tOffsetCentimeter;
+
+    /*
+     * PD controller, positive steering is left
+     */
+    int tSteeringSpeedPWM = -(tOffsetCentimeter * WALL_FOLLOW_KP_PWM_PER_CENTIMETER
+            + sWallFollower.WallAngleDegrees * WALL_FOLLOW_KD_PWM_PER_DEGREE);
+    tSteeringSpeedPWM = constrain(tSteeringSpeedPWM, -WALL_FOLLOW_MAX_STEERING_PWM, WALL_FOLLOW_MAX_STEERING_PWM);
+    int tRightSpeedPWM = constrain(sWallFollower.SpeedPWM + tSteeringSpeedPWM, 0, MAX_SPEED_PWM);
+    int tLeftSpeedPWM = constrain(sWallFollower.SpeedPWM - tSteeringSpeedPWM, 0, MAX_SPEED_PWM);
+#  if defined(DEBUG)
+    Serial.print(F("Wall offset="));
+    Serial.print(tOffsetCentimeter);
+    Serial.print(F(" cm angle="));
+    Serial.print(sWallFollower.WallAngleDegrees);
+    Serial.print(F(" steering="));
+    Serial.println(tSteeringSpeedPWM);
+#  endif
+    RobotCar.setSpeedPWM(tLeftSpeedPWM, tRightSpeedPWM); // for mecanum car, this disables following of the right motor
+    return true;
+}
+#endif // defined(ENABLE_WALL_FOLLOWING)
+#endif // defined(CAR_HAS_DISTANCE_SERVO)
+
+#if defined(ENABLE_ROTATION_SCAN)
+/*
+ * Rotates the car in place from -90 to +90 degree and samples the fixed forward sensor continuously.
+ * Each sample is assigned to the DEGREES_PER_STEP sector of the current IMU turn angle,
+ * and the minimum of all samples of a sector is stored in sForwardDistancesInfo.RawDistancesArray.
+ * The angular speed is kept at ROTATION_SCAN_DEGREES_PER_SECOND by adjusting the PWM with the gyroscope value.
+ * At the end, the car rotates back to the heading at start of scan.
+ * @param aForceScan    If true, do not prematurely return if a GUI event was received
+ * @return true if user cancellation requested.
+ */
+bool fillForwardDistancesInfoByRotation(bool aForceScan) {
+#  if defined(USE_BLUE_DISPLAY_GUI)
+    void (*tLoopCallback)(void) = &loopGUI;
+    sBDEventJustReceived = false;
+#  else
+    (void) aForceScan;
+    void (*tLoopCallback)(void) = NULL;
+#  endif
+    uint8_t *tRawDistancesArray = sForwardDistancesInfo.RawDistancesArray;
+    // Sectors without any valid sample keep the timeout value
+    memset(tRawDistancesArray, AUTONOMOUS_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER, NUMBER_OF_DISTANCES);
+
+    RobotCar.stopAndWaitForIt(tLoopCallback);
+    RobotCar.rotate(ROTATION_SCAN_START_DEGREES, TURN_IN_PLACE, true, tLoopCallback);
+
+    /*
+     * Sweep from right to left. startRotate() resets the IMU turn angle.
+     */
+    RobotCar.startRotate(-2 * ROTATION_SCAN_START_DEGREES, TURN_IN_PLACE, true);
+    uint8_t tSpeedPWM = RobotCar.rightCarMotor.RequestedSpeedPWM;
+    while (RobotCar.updateMotors(tLoopCallback)) {
+#  if defined(USE_BLUE_DISPLAY_GUI)
+        if (!aForceScan && sBDEventJustReceived) {
+            // User sent an event -> stop and return now
+            RobotCar.stop();
+            return true;
+        }
+#  endif
+        int tTurnAngleHalfDegrees = RobotCar.CarTurnAngleHalfDegreesFromIMU; // positive is left
+        if (tTurnAngleHalfDegrees < ((-2 * ROTATION_SCAN_START_DEGREES) - ROTATION_SCAN_SPEED_CONTROL_END_DEGREES) * 2) {
+            /*
+             * Simple integral control of angular speed, one PWM step per sample
+             */
+            unsigned int tDegreesPerSecond = abs(RobotCar.CarTurn2DegreesPerSecondFromIMU) * 2;
+            uint8_t tNewSpeedPWM = tSpeedPWM;
+            if (tDegreesPerSecond < ROTATION_SCAN_DEGREES_PER_SECOND && tSpeedPWM < DEFAULT_DRIVE_SPEED_PWM) {
+                tNewSpeedPWM++;
+            } else if (tDegreesPerSecond > ROTATION_SCAN_DEGREES_PER_SECOND && tSpeedPWM > DEFAULT_START_SPEED_PWM) {
+                tNewSpeedPWM--;
+            }
+            if (tSpeedPWM != tNewSpeedPWM) {
+                tSpeedPWM = tNewSpeedPWM;
+                RobotCar.changeSpeedPWM(tSpeedPWM);
+            }
+        }
+
+        uint8_t tCentimeter = getDistanceAsCentimeter(AUTONOMOUS_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER, true, 0, false);
+        int8_t tIndex = tTurnAngleHalfDegrees / (2 * DEGREES_PER_STEP);
+        if (tIndex < INDEX_RIGHT) {
+            tIndex = INDEX_RIGHT;
+        } else if (tIndex > INDEX_LEFT) {
+            tIndex = INDEX_LEFT;
+        }
+        if (tCentimeter != DISTANCE_TIMEOUT_RESULT && tCentimeter < tRawDistancesArray[tIndex]) {
+            tRawDistancesArray[tIndex] = tCentimeter;
+        }
+    }
+
+    RobotCar.rotate(ROTATION_SCAN_START_DEGREES, TURN_IN_PLACE, true, tLoopCallback);
+    return false;
+}
+
+#  if !defined(CAR_HAS_DISTANCE_SERVO)
+/*
+ * Without distance servo, only the forward distance is available for the follower, so no rotation is computed.
+ * @return  0 -> no turn
+ */
+int8_t scanForTargetAndPrint(uint8_t aMaximumTargetDistance) {
+    uint8_t tCentimeter = getDistanceAsCentimeter(FOLLOWER_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER, true);
+    if (tCentimeter == DISTANCE_TIMEOUT_RESULT) {
+        tCentimeter = FOLLOWER_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER;
+    }
+    memset(sRawForwardDistancesArray, tCentimeter, sizeof(sRawForwardDistancesArray));
+    if (tCentimeter <= aMaximumTargetDistance) {
+        sEffectiveDistanceJustChanged = true; // force movement
+    }
+    sComputedRotation = 0;
+#    if !defined(USE_BLUE_DISPLAY_GUI)
+    printForwardDistanceInfo(&Serial);
+#    endif
+    return 0;
+}
+#  endif
+#endif // defined(ENABLE_ROTATION_SCAN)
+
+#if defined(CAR_HAS_DISTANCE_SERVO) || defined(ENABLE_ROTATION_SCAN)
 void printPadded(uint8_t aByte, Print *aSerial) {
     if (aByte < 10) {
         aSerial->print(' ');
@@ -754,9 +1513,21 @@ void printDistanceRangeCharacter(distance_range_t aRange, Print *aSerial) {
  * @param aForceScan    If true, do not prematurely return if stop was requested i.e. sRuningAutonomousDrive is false
  * @return true if user cancellation requested.
  */
+#  if defined(ENABLE_PIPELINED_SCAN)
+int8_t sPipelinedScanIndex = -1; // -1 -> start new scan at next call of updateForwardDistancesScan()
+#  endif
+void showForwardDistance(uint8_t aDegrees, uint8_t aOldCentimeter, uint8_t aCentimeter);
+
+#  if defined(CAR_HAS_DISTANCE_SERVO)
 bool __attribute__((weak)) fillAndShowForwardDistancesInfo(bool aDoFirstValue, bool aForceScan) {
 
-    color16_t tColor;
+#  if defined(ENABLE_PIPELINED_SCAN)
+    // Fill the scan buffer, values not measured are taken from last scan
+    uint8_t *tRawDistancesArray = sScanningDistancesArray;
+    memcpy(tRawDistancesArray, sForwardDistancesInfo.RawDistancesArray, NUMBER_OF_DISTANCES);
+#  else
+    uint8_t *tRawDistancesArray = sForwardDistancesInfo.RawDistancesArray;
+#  endif
 
 // Values for forward scanning
     uint8_t tCurrentDegrees = START_DEGREES;
@@ -779,6 +1550,16 @@ bool __attribute__((weak)) fillAndShowForwardDistancesInfo(bool aDoFirstValue, b
 
     sBDEventJustReceived = false;
     while (tIndex >= 0 && tIndex < NUMBER_OF_DISTANCES) {
+#  if defined(ENABLE_ADAPTIVE_SCAN)
+        // A complete scan is requested after start or rotation, since all old values are invalid then
+        if (!aDoFirstValue && !isDistanceScanIndexDue(tIndex)) {
+            sDistanceSkippedScansArray[tIndex]++;
+            tIndex += tIndexDelta;
+            tCurrentDegrees += tDeltaDegree;
+            continue;
+        }
+        sDistanceSkippedScansArray[tIndex] = 0;
+#  endif
         /*
          * rotate servo, wait with delayAndLoopGUI() and get distance
          */
@@ -795,43 +1576,216 @@ bool __attribute__((weak)) fillAndShowForwardDistancesInfo(bool aDoFirstValue, b
             // timeout here
             tCentimeter = AUTONOMOUS_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER;
         }
+#  if !defined(ENABLE_COLLISION_GUARD) // Otherwise emergency stop is done by checkForwardCollision() in getDistanceAsCentimeter()
         if ((tIndex == INDEX_FORWARD_1 || tIndex == INDEX_FORWARD_2) && tCentimeter <= sCentimetersDrivenPerScan * 2) {
             /*
              * Emergency motor stop if index is forward and measured distance is less than distance driven during two scans
              */
             RobotCar.stop();
         }
+#  endif
 
-        if (sCurrentPage == PAGE_AUTOMATIC_CONTROL && BlueDisplay1.isConnectionEstablished()) {
-            /*
-             * Determine color
-             */
-            if (tCentimeter >= AUTONOMOUS_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER) {
-                tColor = DISTANCE_TIMEOUT_COLOR; // Cyan
-            } else if (tCentimeter >= sCentimetersDrivenPerScan * 2) {
-                tColor = COLOR16_GREEN;
-            } else if (tCentimeter >= sCentimetersDrivenPerScan) {
-                tColor = COLOR16_YELLOW;
-            } else {
-                tColor = COLOR16_RED; // tCentimeter < sCentimeterDrivenPerScan
-            }
-
-            /*
-             * Clear old and draw new distance line
-             */
-            BlueDisplay1.drawVectorDegrees(US_DISTANCE_MAP_ORIGIN_X, US_DISTANCE_MAP_ORIGIN_Y,
-                    sForwardDistancesInfo.RawDistancesArray[tIndex], tCurrentDegrees, COLOR16_WHITE, 3);
-            BlueDisplay1.drawVectorDegrees(US_DISTANCE_MAP_ORIGIN_X, US_DISTANCE_MAP_ORIGIN_Y, tCentimeter, tCurrentDegrees, tColor,
-                    3);
-        }
-
-        sForwardDistancesInfo.RawDistancesArray[tIndex] = tCentimeter;
+        showForwardDistance(tCurrentDegrees, tRawDistancesArray[tIndex], tCentimeter);
+        tRawDistancesArray[tIndex] = tCentimeter;
 
         tIndex += tIndexDelta;
         tCurrentDegrees += tDeltaDegree;
     }
+#  if defined(ENABLE_PIPELINED_SCAN)
+    swapForwardDistancesBuffers();
+    sPipelinedScanIndex = -1; // Start pipelined scan from current servo position
+#  endif
     return false;
 }
+#  else // defined(CAR_HAS_DISTANCE_SERVO)
+/*
+ * A complete scan by rotation is done if car is stopped or if we have no valid scan. RawDistancesArray[0] == 0 marks an invalid scan.
+ * While driving straight ahead, only the forward distance is measured and stored for both forward indexes.
+ * @return true if user cancellation requested.
+ */
+bool __attribute__((weak)) fillAndShowForwardDistancesInfo(bool aDoFirstValue, bool aForceScan) {
+    (void) aDoFirstValue;
+    uint8_t tOldRawDistancesArray[NUMBER_OF_DISTANCES];
+    memcpy(tOldRawDistancesArray, sForwardDistancesInfo.RawDistancesArray, NUMBER_OF_DISTANCES);
+
+    if (RobotCar.isStopped() || sForwardDistancesInfo.RawDistancesArray[INDEX_RIGHT] == 0) {
+        if (fillForwardDistancesInfoByRotation(aForceScan)) {
+            return true;
+        }
+        for (uint_fast8_t i = 0; i < NUMBER_OF_DISTANCES; ++i) {
+            showForwardDistance(IndexToDegree(i) + 90, tOldRawDistancesArray[i], sForwardDistancesInfo.RawDistancesArray[i]);
+        }
+        return false;
+    }
+
+    auto tCentimeter = getDistanceAsCentimeter(AUTONOMOUS_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER, true, 0, true);
+    if (tCentimeter == DISTANCE_TIMEOUT_RESULT) {
+        tCentimeter = AUTONOMOUS_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER;
+    }
+#    if !defined(ENABLE_COLLISION_GUARD)
+    if (tCentimeter <= sCentimetersDrivenPerScan * 2) {
+        RobotCar.stop();
+    }
+#    endif
+    for (uint_fast8_t i = INDEX_FORWARD_1; i <= INDEX_FORWARD_2; ++i) {
+        showForwardDistance(IndexToDegree(i) + 90, tOldRawDistancesArray[i], tCentimeter);
+        sForwardDistancesInfo.RawDistancesArray[i] = tCentimeter;
+    }
+    return false;
+}
+#  endif // defined(CAR_HAS_DISTANCE_SERVO)
+
+/*
+ * Clear old and draw new distance line on automatic control page
+ */
+void showForwardDistance(uint8_t aDegrees, uint8_t aOldCentimeter, uint8_t aCentimeter) {
+    if (sCurrentPage == PAGE_AUTOMATIC_CONTROL && BlueDisplay1.isConnectionEstablished()) {
+        /*
+         * Determine color
+         */
+        color16_t tColor;
+        if (aCentimeter >= AUTONOMOUS_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER) {
+            tColor = DISTANCE_TIMEOUT_COLOR; // Cyan
+        } else if (aCentimeter >= sCentimetersDrivenPerScan * 2) {
+            tColor = COLOR16_GREEN;
+        } else if (aCentimeter >= sCentimetersDrivenPerScan) {
+            tColor = COLOR16_YELLOW;
+        } else {
+            tColor = COLOR16_RED; // aCentimeter < sCentimeterDrivenPerScan
+        }
+
+        BlueDisplay1.drawVectorDegrees(US_DISTANCE_MAP_ORIGIN_X, US_DISTANCE_MAP_ORIGIN_Y, aOldCentimeter, aDegrees, COLOR16_WHITE,
+                3);
+        BlueDisplay1.drawVectorDegrees(US_DISTANCE_MAP_ORIGIN_X, US_DISTANCE_MAP_ORIGIN_Y, aCentimeter, aDegrees, tColor, 3);
+    }
+}
+
+#  if defined(ENABLE_ADAPTIVE_SCAN)
+uint8_t sDistanceSkippedScansArray[NUMBER_OF_DISTANCES];
+
+/*
+ * Decides if the sector must be measured at this scan.
+ * Forward sectors, sectors with near obstacles and both sectors of an edge are always measured.
+ * Other sectors are skipped more often the faster we drive, so the forward sectors are measured more often.
+ * If car is stopped, all sectors are measured.
+ */
+bool isDistanceScanIndexDue(uint8_t aIndex) {
+    int8_t tDegree = IndexToDegree(aIndex);
+    if (abs(tDegree) <= ADAPTIVE_SCAN_FORWARD_DEGREES) {
+        return true;
+    }
+    uint8_t tCentimeter = sForwardDistancesInfo.RawDistancesArray[aIndex];
+    if (tCentimeter < DISTANCE_MAX_FOR_WALL_DETECTION_CM) {
+        return true;
+    }
+    if ((aIndex > 0 && abs(tCentimeter - sForwardDistancesInfo.RawDistancesArray[aIndex - 1]) >= ADAPTIVE_SCAN_EDGE_CENTIMETER)
+            || (aIndex < NUMBER_OF_DISTANCES - 1
+                    && abs(tCentimeter - sForwardDistancesInfo.RawDistancesArray[aIndex + 1]) >= ADAPTIVE_SCAN_EDGE_CENTIMETER)) {
+        return true;
+    }
+    // 0 for stopped, 3 for MAX_SPEED_PWM
+    uint8_t tMaxSkippedScans = RobotCar.rightCarMotor.CurrentCompensatedSpeedPWM >> 6;
+    if (tMaxSkippedScans > ADAPTIVE_SCAN_MAX_SKIPPED_SCANS) {
+        tMaxSkippedScans = ADAPTIVE_SCAN_MAX_SKIPPED_SCANS;
+    }
+    return sDistanceSkippedScansArray[aIndex] >= tMaxSkippedScans;
+}
+#  endif
+
+#  if defined(ENABLE_PIPELINED_SCAN)
+int8_t sPipelinedScanIndexDelta;
+unsigned long sPipelinedScanServoStopMillis;
+
+void swapForwardDistancesBuffers() {
+    uint8_t *tCompleteScanArray = sScanningDistancesArray;
+    sScanningDistancesArray = sForwardDistancesInfo.RawDistancesArray;
+    sForwardDistancesInfo.RawDistancesArray = tCompleteScanArray;
+}
+
+/*
+ * @return next index to scan, out of range at end of scan
+ */
+static int8_t getNextPipelinedScanIndex(int8_t aIndex) {
+    aIndex += sPipelinedScanIndexDelta;
+#    if defined(ENABLE_ADAPTIVE_SCAN)
+    while (aIndex >= 0 && aIndex < NUMBER_OF_DISTANCES && !isDistanceScanIndexDue(aIndex)) {
+        sDistanceSkippedScansArray[aIndex]++;
+        aIndex += sPipelinedScanIndexDelta;
+    }
+    if (aIndex >= 0 && aIndex < NUMBER_OF_DISTANCES) {
+        sDistanceSkippedScansArray[aIndex] = 0;
+    }
+#    endif
+    return aIndex;
+}
+
+/*
+ * Moves servo without waiting and stores the time when it is expected to be stopped
+ */
+static void startPipelinedScanServo(int8_t aIndex) {
+    uint8_t tDegrees = (aIndex * DEGREES_PER_STEP) + START_DEGREES;
+    uint8_t tLastDegrees = sLastDistanceServoAngleInDegrees;
+    DistanceServoWriteAndWaitForStop(tDegrees, false);
+    sPipelinedScanServoStopMillis = millis() + getDistanceServoWaitMillis(abs(tDegrees - tLastDegrees));
+}
+
+/*
+ * Non blocking version of fillAndShowForwardDistancesInfo(). Call it in loop.
+ * Measures one distance, if servo has reached its position, and starts moving the servo to the next position.
+ * At the end of a scan the buffers are swapped and the servo is already moving for the next scan in reverse direction,
+ * so scanning continues while the planner works on the complete scan in sForwardDistancesInfo.
+ * @return true if a new complete scan is available in sForwardDistancesInfo.RawDistancesArray
+ */
+bool updateForwardDistancesScan() {
+    if (sPipelinedScanIndex < 0) {
+        /*
+         * Start new scan at the side where the servo is. If it is at an end position, this value is taken from last scan.
+         */
+        memcpy(sScanningDistancesArray, sForwardDistancesInfo.RawDistancesArray, NUMBER_OF_DISTANCES);
+        sPipelinedScanIndexDelta = 1;
+        sPipelinedScanIndex = INDEX_RIGHT;
+        if (sLastDistanceServoAngleInDegrees >= 180 - (START_DEGREES + 2)) {
+            sPipelinedScanIndexDelta = -1;
+            sPipelinedScanIndex = INDEX_LEFT - 1;
+        } else if (sLastDistanceServoAngleInDegrees <= START_DEGREES + 2) {
+            sPipelinedScanIndex = INDEX_RIGHT + 1;
+        }
+        startPipelinedScanServo(sPipelinedScanIndex);
+        return false;
+    }
+    if ((long) (millis() - sPipelinedScanServoStopMillis) < 0) {
+        return false; // Servo still moving
+    }
+
+    uint8_t tIndex = sPipelinedScanIndex;
+    uint8_t tMinimumUSDistanceForMinimumMode = (tIndex == 0 || tIndex == NUMBER_OF_DISTANCES - 1) ? 6 : 0;
+    uint8_t tCentimeter = getDistanceAsCentimeter(AUTONOMOUS_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER, true,
+            tMinimumUSDistanceForMinimumMode, tIndex == INDEX_FORWARD_1);
+    if (tCentimeter == DISTANCE_TIMEOUT_RESULT) {
+        tCentimeter = AUTONOMOUS_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER;
+    }
+#    if !defined(ENABLE_COLLISION_GUARD) // Otherwise emergency stop is done by checkForwardCollision() in getDistanceAsCentimeter()
+    if ((tIndex == INDEX_FORWARD_1 || tIndex == INDEX_FORWARD_2) && tCentimeter <= sCentimetersDrivenPerScan * 2) {
+        RobotCar.stop(); // Emergency motor stop like in fillAndShowForwardDistancesInfo()
+    }
+#    endif
+    showForwardDistance(sLastDistanceServoAngleInDegrees, sScanningDistancesArray[tIndex], tCentimeter);
+    sScanningDistancesArray[tIndex] = tCentimeter;
+
+    bool tScanIsComplete = false;
+    sPipelinedScanIndex = getNextPipelinedScanIndex(sPipelinedScanIndex);
+    if (sPipelinedScanIndex < 0 || sPipelinedScanIndex >= NUMBER_OF_DISTANCES) {
+        swapForwardDistancesBuffers();
+        memcpy(sScanningDistancesArray, sForwardDistancesInfo.RawDistancesArray, NUMBER_OF_DISTANCES);
+        // Scan in reverse direction, skip the value just measured
+        sPipelinedScanIndexDelta = -sPipelinedScanIndexDelta;
+        sPipelinedScanIndex = getNextPipelinedScanIndex(tIndex);
+        tScanIsComplete = true;
+    }
+    startPipelinedScanServo(sPipelinedScanIndex);
+    return tScanIsComplete;
+}
+#  endif // defined(ENABLE_PIPELINED_SCAN)
 
 /*
  * Draw values of ActualDistancesArray as vectors
@@ -1163,7 +2117,7 @@ void postProcessDistances(uint8_t aDistanceThreshold) {
         }
     }
 }
-#endif // defined(CAR_HAS_DISTANCE_SERVO)
+#endif // defined(CAR_HAS_DISTANCE_SERVO) || defined(ENABLE_ROTATION_SCAN)
 
 /*
  * Evaluates the US_DISTANCE_SENSOR_ENABLE_PIN switching between IR and US sensor.
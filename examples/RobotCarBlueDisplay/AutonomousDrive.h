@@ -34,6 +34,9 @@
 #if defined(ENABLE_USER_PROVIDED_COLLISION_DETECTION)
 #define MODE_COLLISION_AVOIDING_USER    3 // like MODE_COLLISION_AVOIDING_BUILTIN but use doUserCollisionAvoiding()
 #endif
+#if defined(ENABLE_WALL_FOLLOWING)
+#define MODE_WALL_FOLLOWING             4 // Drive alongside a wall or in the middle of a corridor
+#endif
 extern uint8_t sDriveMode;
 
 /*
@@ -59,6 +62,9 @@ void driveAutonomousOneStep();
 void startStopAutomomousDrive(bool aDoStart, uint8_t aDriveMode = MODE_MANUAL_DRIVE);
 void driveCollisonAvoidingOneStep();
 void driveFollowerModeOneStep();
+#if defined(ENABLE_WALL_FOLLOWING)
+void driveWallFollowingOneStep();
+#endif
 
 #endif // _AUTONOMOUS_DRIVE_H
 #endif // defined(ENABLE_AUTONOMOUS_DRIVE)
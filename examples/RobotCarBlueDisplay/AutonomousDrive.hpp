@@ -49,12 +49,24 @@ uint8_t sCentimetersDrivenPerScan = CENTIMETER_PER_RIDE; // Encoder counts per U
 #else
 uint8_t sCentimetersDrivenPerScan = CENTIMETER_PER_RIDE; // Constant
 #endif
+#if defined(ENABLE_PIPELINED_SCAN)
+// Values at start of current scan. Scans are done without pause while driving, so they are set at the end of the previous scan.
+#  if defined(USE_ENCODER_MOTOR_CONTROL)
+uint16_t sStepStartDistanceCount;
+#  else
+unsigned long sMillisAtStepStart;
+#  endif
+#endif
 
 void driveAutonomousOneStep() {
 
     if (sDriveMode != MODE_MANUAL_DRIVE) {
         if (sDriveMode == MODE_FOLLOWER) {
             driveFollowerModeOneStep();
+#if defined(ENABLE_WALL_FOLLOWING)
+        } else if (sDriveMode == MODE_WALL_FOLLOWING) {
+            driveWallFollowingOneStep();
+#endif
         } else {
             driveCollisonAvoidingOneStep();
         }
@@ -76,10 +88,18 @@ void startStopAutomomousDrive(bool aDoStart, uint8_t aDriveMode) {
         resetPathData();
 #endif
         clearPrintedForwardDistancesInfos(true);
+#if !defined(CAR_HAS_DISTANCE_SERVO)
+        sForwardDistancesInfo.RawDistancesArray[INDEX_RIGHT] = 0; // Car may have been moved, so force a complete rotation scan
+#endif
         sDoStep = true; // enable next step
         sDriveMode = aDriveMode;
 
         // decide which button called us
+#if defined(ENABLE_WALL_FOLLOWING)
+        if (aDriveMode == MODE_WALL_FOLLOWING) {
+            startWallFollowing(RobotCar.rightCarMotor.DriveSpeedPWM);
+        }
+#endif
 #if defined(ENABLE_USER_PROVIDED_COLLISION_DETECTION)
         if (aDriveMode == MODE_COLLISION_AVOIDING_USER) {
             // User mode always starts in mode SINGLE_STEP
@@ -102,7 +122,9 @@ void startStopAutomomousDrive(bool aDoStart, uint8_t aDriveMode) {
             insertToPath(RobotCar.rightCarMotor.EncoderCount, sLastDegreesTurned, true);
         }
 #endif
+#if defined(CAR_HAS_DISTANCE_SERVO)
         DistanceServoWriteAndWaitForStop(90);
+#endif
         sDriveMode = MODE_MANUAL_DRIVE;
         RobotCar.stop(STOP_MODE_RELEASE);
 //        TouchButtonDistanceFeedbackMode.removeButton(COLOR16_WHITE);
@@ -254,11 +276,31 @@ void driveCollisonAvoidingOneStep() {
         /*
          * Here car is (still) moving or just did a rotation or back move and has stooped now
          */
-#if defined(USE_ENCODER_MOTOR_CONTROL)
-        uint16_t tStepStartDistanceCount = RobotCar.rightCarMotor.EncoderCount; // get count before distance scanning
+#if defined(ENABLE_PIPELINED_SCAN)
+        if (sStepMode == MODE_CONTINUOUS && !tCarIsStopped && sNextRotationDegree == 0) {
+            /*
+             * Driving straight ahead. Measure one value per call and do the planning only if a scan is complete.
+             * Then the servo is already moving for the next scan while we do the planning.
+             */
+            if (!updateForwardDistancesScan()) {
+                return;
+            }
+        } else {
+#  if defined(USE_ENCODER_MOTOR_CONTROL)
+            sStepStartDistanceCount = RobotCar.rightCarMotor.EncoderCount; // get count before distance scanning
+#  else
+            sMillisAtStepStart = millis();
+#  endif
+            if (fillAndShowForwardDistancesInfo(tMovementJustStarted)) {
+                return; // User canceled autonomous drive, ForwardDistancesInfo may be incomplete then
+            }
+        }
 #else
+#  if defined(USE_ENCODER_MOTOR_CONTROL)
+        uint16_t tStepStartDistanceCount = RobotCar.rightCarMotor.EncoderCount; // get count before distance scanning
+#  else
         auto tMillisAtStepStart = millis();
-#endif
+#  endif
         /*
          * The magic happens HERE
          * This runs as fast as possible and mainly determine the duration of one step
@@ -266,6 +308,7 @@ void driveCollisonAvoidingOneStep() {
         if (fillAndShowForwardDistancesInfo(tMovementJustStarted)) {
             return; // User canceled autonomous drive, ForwardDistancesInfo may be incomplete then
         }
+#endif
 
         // First clear old decision marker by redrawing it with a white line
         drawCollisionDecision(sNextRotationDegree, sCentimetersDrivenPerScan, true);
@@ -279,23 +322,51 @@ void driveCollisonAvoidingOneStep() {
             /*
              * No stop here => distance is valid
              */
-#if defined(USE_ENCODER_MOTOR_CONTROL)
+#if defined(ENABLE_PIPELINED_SCAN)
+#  if defined(USE_ENCODER_MOTOR_CONTROL)
+            sCentimetersDrivenPerScan = RobotCar.rightCarMotor.EncoderCount - sStepStartDistanceCount;
+            sStepStartDistanceCount = RobotCar.rightCarMotor.EncoderCount; // next scan is already running
+#  else
+            // MillisPerCentimeter is valid for DriveSpeedPWMFor2Volt, so scale by current speed
+            sCentimetersDrivenPerScan = RobotCar.rightCarMotor.convertMillisToMillimeter(RobotCar.rightCarMotor.RequestedSpeedPWM,
+                    millis() - sMillisAtStepStart) / MILLIMETER_IN_ONE_CENTIMETER;
+            sMillisAtStepStart = millis();
+#  endif
+#elif defined(USE_ENCODER_MOTOR_CONTROL)
             // One encoder count is 11 mm so just take the count as centimeter here :-)
             sCentimetersDrivenPerScan = RobotCar.rightCarMotor.EncoderCount - tStepStartDistanceCount;
 #else
-            sCentimetersDrivenPerScan = (millis() - tMillisAtStepStart) / RobotCar.rightCarMotor.MillisPerCentimeter;
+            // MillisPerCentimeter is valid for DriveSpeedPWMFor2Volt, so scale by current speed
+            sCentimetersDrivenPerScan = RobotCar.rightCarMotor.convertMillisToMillimeter(RobotCar.rightCarMotor.RequestedSpeedPWM,
+                    millis() - tMillisAtStepStart) / MILLIMETER_IN_ONE_CENTIMETER;
 #endif
 
 #if !defined(ENABLE_USER_PROVIDED_COLLISION_DETECTION)
             if (sCurrentPage == PAGE_AUTOMATIC_CONTROL) {
                 char tStringBuffer[11];
-                sprintf_P(tStringBuffer, PSTR("%2d%s"), sCentimetersDrivenPerScan, "cm/scan");
+                formatString_P(formatInt(tStringBuffer, sCentimetersDrivenPerScan, 2), PSTR("cm/scan"));
                 BlueDisplay1.drawText(TEXT_SIZE_11_WIDTH, BUTTON_HEIGHT_4_LINE_4 - TEXT_SIZE_11_HEIGHT - TEXT_SIZE_11_DECEND,
                         tStringBuffer, TEXT_SIZE_11, COLOR16_BLACK, COLOR16_WHITE);
             }
 #endif
         }
 
+#if defined(ENABLE_SPEED_GOVERNOR)
+        if (!RobotCar.isStopped() && sStepMode == MODE_CONTINUOUS && sNextRotationDegree == 0) {
+            /*
+             * Adjust speed to the free distance ahead without stopping
+             */
+            uint8_t tFreeCentimeter = sForwardDistancesInfo.RawDistancesArray[INDEX_FORWARD_1];
+            if (tFreeCentimeter > sForwardDistancesInfo.RawDistancesArray[INDEX_FORWARD_2]) {
+                tFreeCentimeter = sForwardDistancesInfo.RawDistancesArray[INDEX_FORWARD_2];
+            }
+            uint8_t tSpeedPWM = getGovernedMaxSpeedPWM(tFreeCentimeter);
+            if (tSpeedPWM > 0) {
+                RobotCar.setSpeedPWMWithRamp(tSpeedPWM, DIRECTION_FORWARD);
+            }
+        }
+#endif
+
         /*
          * Handle stop of car and path data
          */
@@ -331,6 +402,18 @@ void driveCollisonAvoidingOneStep() {
     }
 }
 
+#if defined(ENABLE_WALL_FOLLOWING)
+/*
+ * Wall following runs continuously, step modes are not supported.
+ * Autonomous drive is stopped if an obstacle is ahead.
+ */
+void driveWallFollowingOneStep() {
+    if (!doWallFollowingStep()) {
+        startStopAutomomousDrive(false);
+    }
+}
+#endif
+
 /***************************************************
  * Code for follower mode
  ***************************************************/
@@ -345,7 +428,9 @@ void driveFollowerModeOneStep() {
             /*
              * We have a pending turn
              */
+#if defined(CAR_HAS_DISTANCE_SERVO)
             DistanceServoWriteAndWaitForStop(90, false); // reset distance servo direction
+#endif
             // Use old distance range. Do a cast, since the values of tRange and rotation match!
             RobotCar.rotate(sNextRotationDegree, static_cast<turn_direction_t>(sDistanceRange), false, &loopGUI); // do not use slow speed
             sNextRotationDegree = 0; // reset pending turn
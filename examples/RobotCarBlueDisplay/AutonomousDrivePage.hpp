@@ -71,6 +71,12 @@ const char * const sDistanceSourceModeButtonCaptionStringArray[] PROGMEM = { sDi
 #if defined(ENABLE_USER_PROVIDED_COLLISION_DETECTION)
 BDButton TouchButtonStartStopUserAutonomousDrive;
 #endif
+#if defined(ENABLE_WALL_FOLLOWING)
+#  if defined(ENABLE_USER_PROVIDED_COLLISION_DETECTION)
+#error ENABLE_WALL_FOLLOWING and ENABLE_USER_PROVIDED_COLLISION_DETECTION use the same button position
+#  endif
+BDButton TouchButtonStartStopWallFollowing;
+#endif
 BDButton TouchButtonStartStopBuiltInAutonomousDrive;
 BDButton TouchButtonFollower;
 
@@ -175,6 +181,12 @@ void doStartStopTestUser(BDButton *aTheTouchedButton, int16_t aValue) {
 }
 #endif
 
+#if defined(ENABLE_WALL_FOLLOWING)
+void doStartStopWallFollowing(BDButton *aTheTouchedButton, int16_t aValue) {
+    startStopAutomomousDrive(aValue, MODE_WALL_FOLLOWING);
+}
+#endif
+
 /*
  * set buttons accordingly to sDriveMode
  */
@@ -184,6 +196,9 @@ void handleAutomomousDriveRadioButtons() {
 #if defined(ENABLE_USER_PROVIDED_COLLISION_DETECTION)
     TouchButtonStartStopUserAutonomousDrive.setValue(sDriveMode == MODE_COLLISION_AVOIDING_USER,
             sCurrentPage == PAGE_AUTOMATIC_CONTROL);
+#endif
+#if defined(ENABLE_WALL_FOLLOWING)
+    TouchButtonStartStopWallFollowing.setValue(sDriveMode == MODE_WALL_FOLLOWING, sCurrentPage == PAGE_AUTOMATIC_CONTROL);
 #endif
     TouchButtonFollower.setValue(sDriveMode == MODE_FOLLOWER, sCurrentPage == PAGE_AUTOMATIC_CONTROL);
 }
@@ -219,6 +234,13 @@ void initAutonomousDrivePage(void) {
             &doStartStopTestUser);
     TouchButtonStartStopUserAutonomousDrive.setCaptionForValueTrue(F("Stop User"));
 #endif
+#if defined(ENABLE_WALL_FOLLOWING)
+    TouchButtonStartStopWallFollowing.init(0, BUTTON_HEIGHT_4_LINE_4 - (TEXT_SIZE_22_HEIGHT + BUTTON_DEFAULT_SPACING_QUARTER),
+    BUTTON_WIDTH_3, TEXT_SIZE_22_HEIGHT, COLOR16_RED, F("Start Wall"), TEXT_SIZE_14,
+            FLAG_BUTTON_DO_BEEP_ON_TOUCH | FLAG_BUTTON_TYPE_TOGGLE_RED_GREEN, (sDriveMode == MODE_WALL_FOLLOWING),
+            &doStartStopWallFollowing);
+    TouchButtonStartStopWallFollowing.setCaptionForValueTrue(F("Stop Wall"));
+#endif
 
 #if defined(ENABLE_DISTANCE_FEEDBACK_MODE)
     TouchButtonDistanceFeedbackMode.init(BUTTON_WIDTH_3_POS_2, BUTTON_HEIGHT_4_LINE_4 - (TEXT_SIZE_22_HEIGHT + BUTTON_DEFAULT_SPACING_QUARTER),
@@ -266,6 +288,9 @@ void drawAutonomousDrivePage(void) {
 #if defined(ENABLE_USER_PROVIDED_COLLISION_DETECTION)
     TouchButtonStartStopUserAutonomousDrive.drawButton();
 #endif
+#if defined(ENABLE_WALL_FOLLOWING)
+    TouchButtonStartStopWallFollowing.drawButton();
+#endif
 #if defined(ENABLE_DISTANCE_FEEDBACK_MODE)
     TouchButtonDistanceFeedbackMode.drawButton();
 #endif
@@ -373,8 +398,13 @@ void drawCollisionDecision(int aDegreeToTurn, uint8_t aLengthOfVector, bool aDoC
                 tColor);
         if (!aDoClearVector) {
             //Print result
-            sprintf_P(sBDStringBuffer, PSTR("wall%4d\xB0 rotation: %3d\xB0 wall%4d\xB0"), sForwardDistancesInfo.WallLeftAngleDegrees,
-                    aDegreeToTurn, sForwardDistancesInfo.WallRightAngleDegrees); // \xB0 is degree character
+            char *tBufferEnd = formatString_P(sBDStringBuffer, PSTR("wall"));
+            tBufferEnd = formatInt(tBufferEnd, sForwardDistancesInfo.WallLeftAngleDegrees, 4);
+            tBufferEnd = formatString_P(tBufferEnd, PSTR("\xB0 rotation: ")); // \xB0 is degree character
+            tBufferEnd = formatInt(tBufferEnd, aDegreeToTurn, 3);
+            tBufferEnd = formatString_P(tBufferEnd, PSTR("\xB0 wall"));
+            tBufferEnd = formatInt(tBufferEnd, sForwardDistancesInfo.WallRightAngleDegrees, 4);
+            formatString_P(tBufferEnd, PSTR("\xB0"));
             BlueDisplay1.drawText(BUTTON_WIDTH_3_5_POS_2, US_DISTANCE_MAP_ORIGIN_Y + TEXT_SIZE_11, sBDStringBuffer, TEXT_SIZE_11,
             COLOR16_BLACK, COLOR16_WHITE);
         }
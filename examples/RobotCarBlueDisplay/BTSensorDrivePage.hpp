@@ -134,7 +134,7 @@ void doSensorChange(uint8_t aSensorType, struct SensorCallback *aSensorCallbackI
                 tDirectionForward, SPEED_DEAD_BAND);
 
         //Print speedPWM as value of bottom slider
-        sprintf(sBDStringBuffer, "%3d", tForwardBackwardValue);
+        formatInt(sBDStringBuffer, tForwardBackwardValue, 3);
         SliderBackward.printValue(sBDStringBuffer);
 
         /*
@@ -199,7 +199,7 @@ void doSensorChange(uint8_t aSensorType, struct SensorCallback *aSensorCallbackI
         /*
          * Print speedPWM as value of bottom slider
          */
-        sprintf(sBDStringBuffer, "%4d", tSpeedPWMValue);
+        formatInt(sBDStringBuffer, tSpeedPWMValue, 4);
         SliderBackward.printValue(sBDStringBuffer);
         if (tSpeedPWMValue < 0) {
             tLeftRightValue = -tLeftRightValue;
@@ -0,0 +1,82 @@
+/*
+ * FormatUtils.hpp
+ *
+ *  Small replacement for sprintf_P() for the GUI output, which is called often in loop.
+ *  sprintf_P() requires around 1.5 kB program memory for vfprintf() and several 100 us for each call on AVR.
+ *  All functions write to the buffer, terminate it with '\0' and return the pointer to the terminating '\0',
+ *  so they can be chained to compose a line.
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of Arduino-RobotCar https://github.com/ArminJo/Arduino-RobotCar.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _FORMAT_UTILS_HPP
+#define _FORMAT_UTILS_HPP
+
+#include <Arduino.h>
+
+/*
+ * Like strcpy_P(), but returns end of string
+ * @param aPGMString Use PSTR("...")
+ */
+char* formatString_P(char *aBuffer, const char *aPGMString) {
+    char tChar;
+    while ((tChar = pgm_read_byte(aPGMString++)) != '\0') {
+        *aBuffer++ = tChar;
+    }
+    *aBuffer = '\0';
+    return aBuffer;
+}
+
+/*
+ * Like dtostrf() but for fixed point values, i.e. formatFixedPoint(tBuffer, 745, 5, 2) gives " 7.45"
+ * @param aValue Value * 10^aNumberOfDecimals
+ * @param aWidth Minimum width, output is right aligned and padded with spaces like for "%5d"
+ */
+char* formatFixedPoint(char *aBuffer, int aValue, uint8_t aWidth, uint8_t aNumberOfDecimals) {
+    char tReverseDigits[(sizeof(int) * 3) + 3]; // digits, decimal point and sign
+    unsigned int tValue = aValue;
+    if (aValue < 0) {
+        tValue = -tValue;
+    }
+    uint8_t tLength = 0;
+    do {
+        if (tLength == aNumberOfDecimals && aNumberOfDecimals != 0) {
+            tReverseDigits[tLength++] = '.';
+        }
+        tReverseDigits[tLength++] = '0' + (tValue % 10);
+        tValue /= 10;
+    } while (tValue != 0 || tLength <= aNumberOfDecimals); // Print at least one digit before decimal point
+    if (aValue < 0) {
+        tReverseDigits[tLength++] = '-';
+    }
+
+    while (aWidth > tLength) {
+        *aBuffer++ = ' ';
+        aWidth--;
+    }
+    while (tLength > 0) {
+        *aBuffer++ = tReverseDigits[--tLength];
+    }
+    *aBuffer = '\0';
+    return aBuffer;
+}
+
+/*
+ * Like sprintf(aBuffer, "%<aWidth>d", aValue)
+ */
+char* formatInt(char *aBuffer, int aValue, uint8_t aWidth) {
+    return formatFixedPoint(aBuffer, aValue, aWidth, 0);
+}
+
+#endif // _FORMAT_UTILS_HPP
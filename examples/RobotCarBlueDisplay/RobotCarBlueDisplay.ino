@@ -79,7 +79,9 @@
 #if defined(CAR_HAS_MPU6050_IMU)
 #define USE_MPU6050_IMU             // Requires up to 2850 bytes program memory
 #endif
-#if defined(CAR_HAS_DISTANCE_SENSOR) && defined(CAR_HAS_DISTANCE_SERVO)
+//#define ENABLE_ROTATION_SCAN        // Scan by rotating the car in place, if there is no distance servo. Requires USE_MPU6050_IMU
+//#define ENABLE_WALL_FOLLOWING       // Drive alongside a wall or in the middle of a corridor. Requires CAR_HAS_DISTANCE_SERVO
+#if defined(CAR_HAS_DISTANCE_SENSOR) && (defined(CAR_HAS_DISTANCE_SERVO) || defined(ENABLE_ROTATION_SCAN))
 #define ENABLE_AUTONOMOUS_DRIVE     // Enable if by default, if available
 #endif
 #if defined(CAR_HAS_PAN_SERVO)
@@ -203,7 +203,9 @@ void startStopRobotCar(bool aDoStart) {
          * Stop car
          */
 #if defined(ENABLE_AUTONOMOUS_DRIVE)
+#  if defined(CAR_HAS_DISTANCE_SERVO)
         DistanceServoWriteAndWaitForStop(90);
+#  endif
         sDriveMode = MODE_MANUAL_DRIVE;
 #endif
         RobotCar.stop(STOP_MODE_RELEASE);
@@ -617,10 +619,7 @@ void forceDisplayOfVin() {
 void readAndPrintVin() {
     if (readVINVoltage()) {
         char tDataBuffer[18];
-        char tVCCString[5];
-
-        dtostrf(sVINVoltage, 4, 2, tVCCString);
-        sprintf_P(tDataBuffer, PSTR("%s volt"), tVCCString);
+        formatString_P(formatFixedPoint(tDataBuffer, (int) ((sVINVoltage * 100) + 0.5), 4, 2), PSTR(" volt"));
 
         uint16_t tPosX = BUTTON_WIDTH_8_POS_4;
         uint8_t tPosY;
@@ -659,9 +658,7 @@ void checkForVCCUnderVoltage() {
             BlueDisplay1.drawText(10, 50, F("Battery voltage"), TEXT_SIZE_33, COLOR16_RED, COLOR16_WHITE);
             // Print current "too low" voltage
             char tDataBuffer[18];
-            char tVCCString[6];
-            dtostrf(sVINVoltage, 4, 2, tVCCString);
-            sprintf_P(tDataBuffer, PSTR("%s volt"), tVCCString);
+            formatString_P(formatFixedPoint(tDataBuffer, (int) ((sVINVoltage * 100) + 0.5), 4, 2), PSTR(" volt"));
             BlueDisplay1.drawText(80, 50 + TEXT_SIZE_33_HEIGHT, tDataBuffer);
             BlueDisplay1.drawText(10 + (4 * TEXT_SIZE_33_WIDTH), 50 + (2 * TEXT_SIZE_33_HEIGHT), F("too low"));
         }
@@ -721,8 +718,9 @@ void printMotorValuesPeriodically() {
             if (PWMDcMotor::MotorPWMHasChanged) {
                 PWMDcMotor::MotorPWMHasChanged = false;
                 // position below caption of speed slider
-                sprintf_P(sBDStringBuffer, PSTR("PWM  %3d %3d"), RobotCar.leftCarMotor.CurrentCompensatedSpeedPWM,
-                        RobotCar.rightCarMotor.CurrentCompensatedSpeedPWM);
+                char *tBufferEnd = formatString_P(sBDStringBuffer, PSTR("PWM  "));
+                tBufferEnd = formatString_P(formatInt(tBufferEnd, RobotCar.leftCarMotor.CurrentCompensatedSpeedPWM, 3), PSTR(" "));
+                formatInt(tBufferEnd, RobotCar.rightCarMotor.CurrentCompensatedSpeedPWM, 3);
                 BlueDisplay1.drawText(MOTOR_INFO_START_X, MOTOR_INFO_START_Y + TEXT_SIZE_11, sBDStringBuffer, TEXT_SIZE_11,
                         COLOR16_BLACK, COLOR16_WHITE);
 
@@ -763,14 +761,15 @@ void printMotorValuesPeriodically() {
                  */
                 if (sCurrentPage != PAGE_BT_SENSOR_CONTROL) {
 #if defined(USE_ENCODER_MOTOR_CONTROL)
-                    sprintf_P(sBDStringBuffer, PSTR("tcnt %3d %3d"), RobotCar.leftCarMotor.LastTargetDistanceMillimeter,
-                            RobotCar.rightCarMotor.LastTargetDistanceMillimeter);
+                    char *tBufferEnd = formatString_P(sBDStringBuffer, PSTR("tcnt "));
+                    tBufferEnd = formatString_P(formatInt(tBufferEnd, RobotCar.leftCarMotor.LastTargetDistanceMillimeter, 3), PSTR(" "));
+                    formatInt(tBufferEnd, RobotCar.rightCarMotor.LastTargetDistanceMillimeter, 3);
                     BlueDisplay1.drawText(MOTOR_INFO_START_X, MOTOR_INFO_START_Y + (3 * TEXT_SIZE_11), sBDStringBuffer);
 #else
                     if (RobotCar.rightCarMotor.CheckStopConditionInUpdateMotor
                             || RobotCar.leftCarMotor.CheckStopConditionInUpdateMotor) {
-                        sprintf_P(sBDStringBuffer, PSTR("%5d %5d"), RobotCar.leftCarMotor.computedMillisOfMotorForDistance,
-                                RobotCar.rightCarMotor.computedMillisOfMotorForDistance);
+                        char *tBufferEnd = formatInt(sBDStringBuffer, RobotCar.leftCarMotor.computedMillisOfMotorForDistance, 5);
+                        formatInt(formatString_P(tBufferEnd, PSTR(" ")), RobotCar.rightCarMotor.computedMillisOfMotorForDistance, 5);
                         BlueDisplay1.drawText(MOTOR_INFO_START_X, MOTOR_INFO_START_Y + (3 * TEXT_SIZE_11), sBDStringBuffer,
                                 TEXT_SIZE_11, COLOR16_BLACK, COLOR16_WHITE);
                     }
@@ -784,8 +783,9 @@ void printMotorValuesPeriodically() {
             if (PWMDcMotor::MotorControlValuesHaveChanged) {
                 PWMDcMotor::MotorControlValuesHaveChanged = false;
 //                if (RobotCar.leftCarMotor.SpeedPWMCompensation != 0 || RobotCar.rightCarMotor.SpeedPWMCompensation != 0) {
-                sprintf_P(sBDStringBuffer, PSTR("comp %3d %3d"), -RobotCar.leftCarMotor.SpeedPWMCompensation,
-                        -RobotCar.rightCarMotor.SpeedPWMCompensation);
+                char *tBufferEnd = formatString_P(sBDStringBuffer, PSTR("comp "));
+                tBufferEnd = formatString_P(formatInt(tBufferEnd, -RobotCar.leftCarMotor.SpeedPWMCompensation, 3), PSTR(" "));
+                formatInt(tBufferEnd, -RobotCar.rightCarMotor.SpeedPWMCompensation, 3);
                 BlueDisplay1.drawText(MOTOR_INFO_START_X, MOTOR_INFO_START_Y + (4 * TEXT_SIZE_11), sBDStringBuffer, TEXT_SIZE_11,
                         COLOR16_BLACK, COLOR16_WHITE);
 //                }
@@ -841,8 +841,8 @@ void printMotorSpeedSensorValues() {
     } else {
         tYPos = MOTOR_INFO_START_Y;
     }
-    sprintf_P(sBDStringBuffer, PSTR("cnt.%4d%4d"), RobotCar.leftCarMotor.EncoderCount,
-            RobotCar.rightCarMotor.EncoderCount);
+    formatInt(formatInt(formatString_P(sBDStringBuffer, PSTR("cnt.")), RobotCar.leftCarMotor.EncoderCount, 4),
+            RobotCar.rightCarMotor.EncoderCount, 4);
     BlueDisplay1.drawText(MOTOR_INFO_START_X, tYPos, sBDStringBuffer, TEXT_SIZE_11, COLOR16_BLACK, COLOR16_WHITE);
 #  endif
 
@@ -850,8 +850,8 @@ void printMotorSpeedSensorValues() {
     /*
      * Print distance and rotation from IMU
      */
-    sprintf_P(sBDStringBuffer, PSTR("%5dcm%4d\xB0"), RobotCar.IMUData.getDistanceCm(),
-            RobotCar.CarTurnAngleHalfDegreesFromIMU / 2);
+    char *tBufferEnd = formatString_P(formatInt(sBDStringBuffer, RobotCar.IMUData.getDistanceCm(), 5), PSTR("cm"));
+    formatString_P(formatInt(tBufferEnd, RobotCar.CarTurnAngleHalfDegreesFromIMU / 2, 4), PSTR("\xB0")); // \xB0 is degree character
     BlueDisplay1.drawText(MOTOR_INFO_START_X, MOTOR_INFO_START_Y, sBDStringBuffer, TEXT_SIZE_11, COLOR16_BLACK, COLOR16_WHITE);
 #  endif
 }
@@ -862,8 +862,8 @@ void printMotorSpeedSensorValues() {
 void printIMUOffsetValues() {
     if (RobotCar.IMUData.OffsetsJustHaveChanged) {
         RobotCar.IMUData.OffsetsJustHaveChanged = false;
-        sprintf_P(sBDStringBuffer, PSTR("off.%4d%4d"), RobotCar.IMUData.AcceleratorForwardOffset,
-                RobotCar.IMUData.GyroscopePanOffset);
+        formatInt(formatInt(formatString_P(sBDStringBuffer, PSTR("off.")), RobotCar.IMUData.AcceleratorForwardOffset, 4),
+                RobotCar.IMUData.GyroscopePanOffset, 4);
         BlueDisplay1.drawText(MOTOR_INFO_START_X, MOTOR_INFO_START_Y + (5 * TEXT_SIZE_11), sBDStringBuffer, TEXT_SIZE_11,
         COLOR16_BLACK, COLOR16_WHITE);
     }
@@ -20,6 +20,7 @@
 
 #include "BlueDisplay.h"
 #include "AutonomousDrive.h"
+#include "FormatUtils.hpp" // formatInt() etc. instead of sprintf_P() to save program memory and time
 
 // can be deleted for BlueDisplay library version > 2.1.0
 # if not defined(BUTTON_WIDTH_3_5_POS_2)
@@ -35,6 +35,7 @@ void goForward();
 void goBackward();
 void turnLeft();
 void turnRight();
+void setDriveSpeedPWMSmooth(uint8_t aDriveSpeedPWM);
 void doDefaultSpeed();
 #define SPEED_PWM_CHANGE_VALUE  ((MAX_SPEED_PWM + 1) / 16) // 16
 void doIncreaseSpeed();
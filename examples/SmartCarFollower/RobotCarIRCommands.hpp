@@ -107,11 +107,27 @@ void turnRight() {
     RobotCar.startRotate(-15, TURN_IN_PLACE);
 }
 
+/*
+ * Sets the new drive speed and changes the speed of a car, which drives without target distance, without PWM jump.
+ * Blending is done by updateMotors() in loop. Fixed distance movements keep their speed,
+ * since blending would disable their stop condition.
+ */
+void setDriveSpeedPWMSmooth(uint8_t aDriveSpeedPWM) {
+    RobotCar.setDriveSpeedPWM(aDriveSpeedPWM);
+    if (!RobotCar.isStopped() && !RobotCar.rightCarMotor.CheckStopConditionInUpdateMotor) {
+        if (RobotCar.getCarDirection() == DIRECTION_FORWARD) {
+            RobotCar.setSpeedPWMAndDirectionSmooth(aDriveSpeedPWM);
+        } else if (RobotCar.getCarDirection() == DIRECTION_BACKWARD) {
+            RobotCar.setSpeedPWMAndDirectionSmooth(-(int) aDriveSpeedPWM);
+        }
+    }
+}
+
 /*
  * Set driving speed PWM to default, which depends on motor supply voltage.
  */
 void doDefaultSpeed() {
-    RobotCar.setDriveSpeedPWM(RobotCar.rightCarMotor.DriveSpeedPWMFor2Volt);
+    setDriveSpeedPWMSmooth(RobotCar.rightCarMotor.DriveSpeedPWMFor2Volt);
     RobotCar.rightCarMotor.printValues(&Serial);
 }
 
@@ -124,7 +140,7 @@ void doIncreaseSpeed() {
         // unsigned overflow happened here
         tNewSpeed = MAX_SPEED_PWM;
     }
-    RobotCar.setDriveSpeedPWM(tNewSpeed);
+    setDriveSpeedPWMSmooth(tNewSpeed);
     RobotCar.rightCarMotor.printValues(&Serial);
 }
 
@@ -133,7 +149,7 @@ void doDecreaseSpeed() {
     if (tNewSpeed < DEFAULT_START_SPEED_PWM) {
         tNewSpeed = DEFAULT_START_SPEED_PWM;
     }
-    RobotCar.setDriveSpeedPWM(tNewSpeed);
+    setDriveSpeedPWMSmooth(tNewSpeed);
     RobotCar.rightCarMotor.printValues(&Serial);
 }
 
@@ -147,6 +163,15 @@ void doCalibrate() {
     calibrateDriveSpeedPWMAndPrint();
 #endif
 
+#if defined(USE_ENCODER_MOTOR_CONTROL) && defined(_ROBOT_CAR_DISTANCE_HPP)
+    /*
+     * Start wheel circumference calibration, car must face a wall at a distance between 50 cm and 2 meter
+     */
+    if (!calibrateMillimeterPerCountAtWall()) {
+        DELAY_AND_RETURN_IF_STOP(2000);
+    }
+#endif
+
 #if !defined(USE_MPU6050_IMU) && (defined(_IR_COMMAND_DISPATCHER_HPP) || defined(VERSION_BLUE_DISPLAY)) \
     && (defined(CAR_HAS_4_WHEELS) || defined(CAR_HAS_4_MECANUM_WHEELS) || !defined(USE_ENCODER_MOTOR_CONTROL))
     // Not for 4WD cars with IMU or 2WD car with encoder motor.
@@ -63,7 +63,10 @@
 //#define MOTOR_SHIELD_4WD_BASIC_CONFIGURATION          // Adafruit Motor Shield using TB6612 mosfet bridge. 2 Li-ion + VIN voltage divider + servo head down
 //#define MOTOR_SHIELD_4WD_FULL_CONFIGURATION           // Motor Shield + encoder + 2 Li-ion + servo head down + IR distance
 //#define MECANUM_US_DISTANCE_CONFIGURATION             // Nano Breadboard version with Arduino NANO, TB6612 mosfet bridge and 4 mecanum wheels + US distance + servo
+//#define ENABLE_SMOOTH_SPEED_CHANGE  // Blend speed and direction changes of the follower by updateMotors() instead of setting them immediately.
+#if !defined(ENABLE_SMOOTH_SPEED_CHANGE)
 #define DO_NOT_SUPPORT_RAMP         // Ramps are anyway not used if drive speed voltage (default 2.0 V) is below 2.3 V. Saves 378 bytes program memory.
+#endif
 #define DO_NOT_SUPPORT_AVERAGE_SPEED // Disables the function getAverageSpeed(). Saves 44 bytes RAM per motor and 156 bytes program memory.
 #define USE_SOFT_I2C_MASTER             // Saves 2110 bytes program memory and 200 bytes RAM for I2C communication to Adafruit motor shield and MPU6050 IMU compared with Arduino Wire
 
@@ -99,6 +102,9 @@ bool sVINProvided = false;
 #define CAR_HAS_DISTANCE_SERVO // To avoid subsequent errors
 #endif
 //#define DISTANCE_SERVO_TRIM_DEGREE (-10) // Value is added to all degrees in DistanceServoWriteAndWaitForStop()
+//#define ENABLE_TARGET_TRACKING      // Keep servo pointed at target and steer towards it while driving, instead of scanning at 70, 90 and 110 degree
+//#define TOF_USE_MULTI_ZONE          // Use right, forward and left zone of the VL53L1X ToF sensor instead of scanning with the servo
+//#define TOF_ZONES_MIRRORED          // Swaps right and left zone, if sensor is mounted upside down
 
 #if defined(CAR_HAS_MPU6050_IMU)
 #define USE_MPU6050_IMU             // Enable it by default, if available
@@ -251,7 +257,7 @@ void setup() {
 }
 
 void loop() {
-#if defined(USE_ENCODER_MOTOR_CONTROL)
+#if defined(USE_ENCODER_MOTOR_CONTROL) || defined(ENABLE_SMOOTH_SPEED_CHANGE)
     RobotCar.updateMotors();
 #endif
 
@@ -260,7 +266,7 @@ void loop() {
         /*
          * IR mode her
          */
-#if !defined(USE_ENCODER_MOTOR_CONTROL) // Call it here if not at start of loop
+#if !defined(USE_ENCODER_MOTOR_CONTROL) && !defined(ENABLE_SMOOTH_SPEED_CHANGE) // Call it here if not at start of loop
         RobotCar.updateMotors(); // enables going fixed distance started by IR command
 #endif
         /*
@@ -334,11 +340,34 @@ void doFollowerOneStep(bool aEnableScanAndTurn) {
     unsigned int tForwardCentimeter;
     int8_t tRotationDegree = 0; // only set if sEnableFollower == true
 
+#if defined(ENABLE_TARGET_TRACKING)
+    if (aEnableScanAndTurn) {
+        /*
+         * Keep servo pointed at target and steer while driving. Rotate only if target is too far sideways.
+         */
+        if (trackTarget(FOLLOWER_TARGET_DISTANCE_TIMEOUT_CENTIMETER - 1)) { // -1 otherwise timeout is handled as found.
+            tForwardCentimeter = sTargetTracker.Centimeter;
+            if (abs(sTargetTracker.BearingDegrees) > TARGET_TRACKING_STEERING_DEGREES) {
+                tRotationDegree = sTargetTracker.BearingDegrees;
+            }
+        } else {
+            tForwardCentimeter = FOLLOWER_DISPLAY_DISTANCE_TIMEOUT_CENTIMETER;
+        }
+        sEffectiveDistanceJustChanged = true; // Bearing may have changed, so update steering
+    } else
+#endif
     if (aEnableScanAndTurn && sLastRange == DISTANCE_TARGET_NOT_FOUND && sMillisOfLastMovement > 0) {
+#if defined(CAR_HAS_TOF_DISTANCE_SENSOR) && defined(TOF_USE_MULTI_ZONE)
+        /*
+         * Measure right, forward and left zone of ToF sensor, no servo movement required
+         */
+        tRotationDegree = scanForTargetWithToFZones(FOLLOWER_TARGET_DISTANCE_TIMEOUT_CENTIMETER - 1);
+#else
         /*
          * Scan for target at 70, 90 and 110 degree
          */
         tRotationDegree = scanForTargetAndPrint(FOLLOWER_TARGET_DISTANCE_TIMEOUT_CENTIMETER - 1); // -1 otherwise timeout is handled as found.
+#endif
         // Read forward distance for the case that rotation is 0 and sEffectiveDistanceJustChanged is true, i.e. target was found ahead.
         tForwardCentimeter = sRawForwardDistancesArray[INDEX_TARGET_FORWARD]; // Values between 1 and FOLLOWER_TARGET_DISTANCE_MAXIMUM_CENTIMETER
 
@@ -371,6 +400,9 @@ void doFollowerOneStep(bool aEnableScanAndTurn) {
         // Do a cast, since the values of tRange and rotation match!
         RobotCar.rotate(tRotationDegree, TURN_FORWARD, false);
         sRawForwardDistancesArray[INDEX_TARGET_FORWARD] = 0; // Force sEffectiveDistanceJustChanged to be true at next loop, since we have stopped here.
+#if defined(ENABLE_TARGET_TRACKING)
+        sTargetTracker.BearingDegrees -= tRotationDegree;
+#endif
         // Make a fresh scan, before moving
 
     } else if (sEffectiveDistanceJustChanged) {
@@ -396,6 +428,13 @@ void doFollowerOneStep(bool aEnableScanAndTurn) {
             uint8_t tDifferenceCentimeter = tForwardCentimeter - FOLLOWER_DISTANCE_MAXIMUM_CENTIMETER;
             tNewSpeedPWM = PWMDcMotor::getVoltageAdjustedSpeedPWM(DEFAULT_START_SPEED_PWM, sVINVoltage) + tDifferenceCentimeter * 4; // maximum is + 120 here
             tDirection = DIRECTION_FORWARD;
+#if defined(ENABLE_TARGET_TRACKING)
+            // Add speed of target moving away
+            int tRangeRateSpeedPWM = getTargetRangeRateSpeedPWM();
+            if (tRangeRateSpeedPWM > 0) {
+                tNewSpeedPWM += tRangeRateSpeedPWM;
+            }
+#endif
 
         } else if (tRange == DISTANCE_TO_SMALL) {
             /*
@@ -422,33 +461,46 @@ void doFollowerOneStep(bool aEnableScanAndTurn) {
             Serial.print(' ');
         }
 
+        /*
+         * Clip speed, since we have a delay introduced by scanning,
+         * and we do not want that the car is moving from minimum to maximum or back during this delay.
+         * And additionally, it seems that to much speed generates high frequency noise, which disturbs the US sensor.
+         */
+        uint8_t tMaxSpeed = DEFAULT_DRIVE_SPEED_PWM + (DEFAULT_DRIVE_SPEED_PWM / 2); // Corresponds to 3 volt
+        if (sDoSlowScan) {
+            tMaxSpeed = DEFAULT_DRIVE_SPEED_PWM; // reduce max speed further to 2 volt
+        }
+#if defined(ENABLE_SPEED_GOVERNOR)
+        if (tDirection == DIRECTION_FORWARD) {
+            // Clip additionally to the speed, at which we can still stop before the minimum distance. 0 stops the car below.
+            tMaxSpeed = min(tMaxSpeed, getGovernedMaxSpeedPWM(tForwardCentimeter - FOLLOWER_DISTANCE_MINIMUM_CENTIMETER));
+        }
+#endif
+        if (tNewSpeedPWM > tMaxSpeed) {
+            tNewSpeedPWM = tMaxSpeed;
+        }
+
         /*
          * Process new speed
          */
         if (tNewSpeedPWM != 0) {
-            /*
-             * Clip speed, since we have a delay introduced by scanning,
-             * and we do not want that the car is moving from minimum to maximum or back during this delay.
-             * And additionally, it seems that to much speed generates high frequency noise, which disturbs the US sensor.
-             */
-            uint8_t tMaxSpeed = DEFAULT_DRIVE_SPEED_PWM + (DEFAULT_DRIVE_SPEED_PWM / 2); // Corresponds to 3 volt
-            if (sDoSlowScan) {
-                tMaxSpeed = DEFAULT_DRIVE_SPEED_PWM; // reduce max speed further to 2 volt
-            }
-            if (tNewSpeedPWM > tMaxSpeed) {
-                tNewSpeedPWM = tMaxSpeed;
-            }
             Serial.print(F("SpeedPWM="));
             Serial.println(tNewSpeedPWM);
             /*
              * Set speed and direction
              */
+#if defined(ENABLE_TARGET_TRACKING)
+            setSpeedPWMAndDirectionWithTargetBearing(tNewSpeedPWM, tDirection);
+#elif defined(ENABLE_SMOOTH_SPEED_CHANGE)
+            RobotCar.setSpeedPWMAndDirectionSmooth((tDirection == DIRECTION_BACKWARD) ? -(int) tNewSpeedPWM : (int) tNewSpeedPWM);
+#else
             RobotCar.setSpeedPWMAndDirection(tNewSpeedPWM, tDirection);
+#endif
 
             sMillisOfLastMovement = millis();
         } else {
             /*
-             * STOP - Target is in the right distance, or we have a timeout
+             * STOP - Target is in the right distance, or we have a timeout, or the speed governor stops the car
              */
             if (!RobotCar.isStopped()) {
                 RobotCar.stop(STOP_MODE_RELEASE); // stop only once
@@ -456,6 +508,10 @@ void doFollowerOneStep(bool aEnableScanAndTurn) {
             } else {
                 if (tRange == DISTANCE_OK) {
                     Serial.println(F("ok"));
+#if defined(ENABLE_SPEED_GOVERNOR)
+                } else if (tRange == DISTANCE_TO_GREAT) {
+                    Serial.println(F("governed stop"));
+#endif
                 } else {
                     // tRange == DISTANCE_TIMEOUT here
                     Serial.println(F("searching"));
@@ -0,0 +1,78 @@
+/*
+ * CarBackEMFSpeedControl.h
+ *
+ *  Closed loop speed control for cars without encoders.
+ *  The speed of each motor is estimated from its back EMF, which is sampled while the motor coasts for a short time.
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_BACK_EMF_SPEED_CONTROL_H
+#define _CAR_BACK_EMF_SPEED_CONTROL_H
+
+#include "CarPWMMotorControl.h"
+
+#if defined(CAR_HAS_4_MECANUM_WHEELS)
+#error Back EMF speed control supports only 2 motors / motor sets
+#endif
+
+#if !defined(BACK_EMF_SETTLE_MICROS)
+#define BACK_EMF_SETTLE_MICROS              500 // The current of the motor inductance must have decayed before sampling
+#endif
+#if !defined(BACK_EMF_SAMPLE_PERIOD_MILLIS)
+#define BACK_EMF_SAMPLE_PERIOD_MILLIS        50 // Coasting for 0.5 ms every 50 ms costs only 1% of torque
+#endif
+// Speed per back EMF volt. Back EMF is lower than the motor voltage, so this is only a first guess.
+#define BACK_EMF_DEFAULT_MILLIMETER_PER_SECOND_PER_VOLT ((DEFAULT_MILLIMETER_PER_SECOND * 1000L) / DEFAULT_DRIVE_MILLIVOLT) // 115, 100 for mecanum car
+#define BACK_EMF_CONTROL_GAIN_Q8             64 // PWM change per mm/s speed error * 256 for each sample. Integral controller.
+#define BACK_EMF_CONTROL_MAX_PWM_STEP         8 // Maximum PWM change for each sample
+
+#define BACK_EMF_RIGHT_MOTOR_INDEX  0
+#define BACK_EMF_LEFT_MOTOR_INDEX   1
+
+class CarBackEMFSpeedControl {
+public:
+    CarBackEMFSpeedControl();
+    void init(uint16_t (*aReadBackEMFMillivoltFunction)(uint8_t aMotorIndex));
+    void setMillimeterPerSecondPerVolt(uint16_t aRightMillimeterPerSecondPerVolt, uint16_t aLeftMillimeterPerSecondPerVolt);
+    void setSpeedMillimeterPerSecond(uint16_t aRequestedMillimeterPerSecond, uint8_t aRequestedDirection);
+    void stop();
+    bool update(); // Call it in your loop. Returns true if new speed values were measured
+    void printValues(Print *aSerial);
+
+    /*
+     * Internal functions
+     */
+    uint16_t measureBackEMFMillivolt(PWMDcMotor *aMotor, uint8_t aMotorIndex);
+    void updateMotor(PWMDcMotor *aMotor, uint8_t aMotorIndex);
+
+    /*
+     * Must return the voltage between the terminals of the motor with index 0 = right, 1 = left, e.g. by using ADCUtils.
+     * It is called while the motor driver outputs are released.
+     */
+    uint16_t (*ReadBackEMFMillivoltFunction)(uint8_t aMotorIndex);
+    uint16_t MillimeterPerSecondPerVolt[2];  // Per motor constant to convert back EMF to speed
+    uint16_t SpeedMillimeterPerSecond[2];    // Estimated and low pass filtered speed
+    uint16_t TargetMillimeterPerSecond;      // 0 -> speed is only estimated, but not controlled
+    unsigned long LastSampleMillis;
+};
+
+extern CarBackEMFSpeedControl BackEMFSpeedControl;
+
+#endif // _CAR_BACK_EMF_SPEED_CONTROL_H
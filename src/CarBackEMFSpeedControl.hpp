@@ -0,0 +1,162 @@
+/*
+ * CarBackEMFSpeedControl.hpp
+ *
+ *  Closed loop speed control for cars without encoders.
+ *
+ *  Every BACK_EMF_SAMPLE_PERIOD_MILLIS, each running motor is released for BACK_EMF_SETTLE_MICROS, i.e. the PWM off phase is extended.
+ *  After the flyback current has decayed, the voltage at the motor terminals is the back EMF, which is proportional to the speed.
+ *  No ADC reads are done here, the sketch must provide the function for reading the terminal voltage, e.g. by using ADCUtils.
+ *  The speed is then used by an integral controller, which adjusts the PWM of each motor to reach the requested speed.
+ *
+ *  Requires CarPWMMotorControl.hpp
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_BACK_EMF_SPEED_CONTROL_HPP
+#define _CAR_BACK_EMF_SPEED_CONTROL_HPP
+
+#include "CarBackEMFSpeedControl.h"
+
+#if defined(DEBUG)
+#define LOCAL_DEBUG
+#else
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+#endif
+
+CarBackEMFSpeedControl BackEMFSpeedControl;
+
+CarBackEMFSpeedControl::CarBackEMFSpeedControl() { // @suppress("Class members should be properly initialized")
+    MillimeterPerSecondPerVolt[BACK_EMF_RIGHT_MOTOR_INDEX] = BACK_EMF_DEFAULT_MILLIMETER_PER_SECOND_PER_VOLT;
+    MillimeterPerSecondPerVolt[BACK_EMF_LEFT_MOTOR_INDEX] = BACK_EMF_DEFAULT_MILLIMETER_PER_SECOND_PER_VOLT;
+}
+
+/*
+ * @param aReadBackEMFMillivoltFunction Returns the voltage between the terminals of the motor with index 0 = right or 1 = left
+ */
+void CarBackEMFSpeedControl::init(uint16_t (*aReadBackEMFMillivoltFunction)(uint8_t aMotorIndex)) {
+    ReadBackEMFMillivoltFunction = aReadBackEMFMillivoltFunction;
+}
+
+/*
+ * Values can be determined by driving a known distance at constant speed and comparing its duration with SpeedMillimeterPerSecond.
+ */
+void CarBackEMFSpeedControl::setMillimeterPerSecondPerVolt(uint16_t aRightMillimeterPerSecondPerVolt,
+        uint16_t aLeftMillimeterPerSecondPerVolt) {
+    MillimeterPerSecondPerVolt[BACK_EMF_RIGHT_MOTOR_INDEX] = aRightMillimeterPerSecondPerVolt;
+    MillimeterPerSecondPerVolt[BACK_EMF_LEFT_MOTOR_INDEX] = aLeftMillimeterPerSecondPerVolt;
+}
+
+/*
+ * Starts the motors with the PWM estimated from DriveSpeedPWMFor2Volt, the controller then adjusts it to the requested speed.
+ * @param aRequestedMillimeterPerSecond 0 stops the car
+ */
+void CarBackEMFSpeedControl::setSpeedMillimeterPerSecond(uint16_t aRequestedMillimeterPerSecond, uint8_t aRequestedDirection) {
+    TargetMillimeterPerSecond = aRequestedMillimeterPerSecond;
+    if (aRequestedMillimeterPerSecond == 0) {
+        RobotCar.stop();
+        return;
+    }
+    if (!RobotCar.isStopped() && RobotCar.getCarDirection() != aRequestedDirection) {
+        RobotCar.stop(); // Do not reverse with the current PWM, but start again with the estimated PWM
+    }
+    if (RobotCar.isStopped()) {
+        uint16_t tSpeedPWM = ((uint32_t) aRequestedMillimeterPerSecond * RobotCar.rightCarMotor.DriveSpeedPWMFor2Volt)
+                / DEFAULT_MILLIMETER_PER_SECOND;
+        if (tSpeedPWM > MAX_SPEED_PWM) {
+            tSpeedPWM = MAX_SPEED_PWM;
+        }
+        RobotCar.setSpeedPWMAndDirection(tSpeedPWM, aRequestedDirection);
+    }
+}
+
+void CarBackEMFSpeedControl::stop() {
+    setSpeedMillimeterPerSecond(0, DIRECTION_STOP);
+}
+
+/*
+ * Releases the motor driver outputs, waits for the flyback current to decay and reads the back EMF.
+ * The PWM / enable output is set to 0 too, because on a L298 both direction inputs low with enable high is a brake.
+ * Direction and PWM are restored afterwards.
+ */
+uint16_t CarBackEMFSpeedControl::measureBackEMFMillivolt(PWMDcMotor *aMotor, uint8_t aMotorIndex) {
+    uint8_t tDirection = aMotor->CurrentDirection;
+    aMotor->writeSpeedPWM(0);
+    aMotor->setMotorDriverMode(STOP_MODE_RELEASE);
+    delayMicroseconds(BACK_EMF_SETTLE_MICROS);
+    uint16_t tBackEMFMillivolt = ReadBackEMFMillivoltFunction(aMotorIndex);
+    aMotor->setMotorDriverMode(tDirection);
+    aMotor->writeSpeedPWM(aMotor->CurrentCompensatedSpeedPWM);
+    return tBackEMFMillivolt;
+}
+
+void CarBackEMFSpeedControl::updateMotor(PWMDcMotor *aMotor, uint8_t aMotorIndex) {
+    if (aMotor->isStopped()) {
+        SpeedMillimeterPerSecond[aMotorIndex] = 0;
+        return;
+    }
+    uint16_t tSpeedMillimeterPerSecond = ((uint32_t) measureBackEMFMillivolt(aMotor, aMotorIndex)
+            * MillimeterPerSecondPerVolt[aMotorIndex]) / 1000;
+    // Low pass of 1/2 against commutator ripple
+    SpeedMillimeterPerSecond[aMotorIndex] = (SpeedMillimeterPerSecond[aMotorIndex] + tSpeedMillimeterPerSecond) / 2;
+
+    if (TargetMillimeterPerSecond != 0) {
+        int tDeltaSpeedPWM = ((int32_t) ((int) TargetMillimeterPerSecond - (int) SpeedMillimeterPerSecond[aMotorIndex])
+                * BACK_EMF_CONTROL_GAIN_Q8) >> 8;
+        tDeltaSpeedPWM = constrain(tDeltaSpeedPWM, -BACK_EMF_CONTROL_MAX_PWM_STEP, BACK_EMF_CONTROL_MAX_PWM_STEP);
+        int tNewSpeedPWM = constrain((int) aMotor->RequestedSpeedPWM + tDeltaSpeedPWM, (int) DEFAULT_START_SPEED_PWM,
+                (int) MAX_SPEED_PWM);
+        aMotor->setSpeedPWM(tNewSpeedPWM);
+    }
+}
+
+/*
+ * Measures and controls both motors every BACK_EMF_SAMPLE_PERIOD_MILLIS
+ * @return true if new speed values were measured
+ */
+bool CarBackEMFSpeedControl::update() {
+    if (ReadBackEMFMillivoltFunction == NULL || millis() - LastSampleMillis < BACK_EMF_SAMPLE_PERIOD_MILLIS) {
+        return false;
+    }
+    LastSampleMillis = millis();
+    updateMotor(&RobotCar.rightCarMotor, BACK_EMF_RIGHT_MOTOR_INDEX);
+    updateMotor(&RobotCar.leftCarMotor, BACK_EMF_LEFT_MOTOR_INDEX);
+#if defined(LOCAL_DEBUG)
+    printValues(&Serial);
+#endif
+    return true;
+}
+
+void CarBackEMFSpeedControl::printValues(Print *aSerial) {
+    aSerial->print(F("Back EMF speed right="));
+    aSerial->print(SpeedMillimeterPerSecond[BACK_EMF_RIGHT_MOTOR_INDEX]);
+    aSerial->print(F(" left="));
+    aSerial->print(SpeedMillimeterPerSecond[BACK_EMF_LEFT_MOTOR_INDEX]);
+    aSerial->print(F(" mm/s target="));
+    aSerial->print(TargetMillimeterPerSecond);
+    aSerial->print(F(" PWM right="));
+    aSerial->print(RobotCar.rightCarMotor.RequestedSpeedPWM);
+    aSerial->print(F(" left="));
+    aSerial->println(RobotCar.leftCarMotor.RequestedSpeedPWM);
+}
+
+#if defined(LOCAL_DEBUG)
+#undef LOCAL_DEBUG
+#endif
+#endif // _CAR_BACK_EMF_SPEED_CONTROL_HPP
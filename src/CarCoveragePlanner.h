@@ -0,0 +1,96 @@
+/*
+ * CarCoveragePlanner.h
+ *
+ *  Boustrophedon (back and forth lanes) coverage of a rectangular area, e.g. for cleaning or mowing robots.
+ *  The area is divided into square cells, visited and blocked cells are stored in 2 bitmaps.
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_COVERAGE_PLANNER_H
+#define _CAR_COVERAGE_PLANNER_H
+
+#include "CarPathFollower.h"
+
+#if !defined(COVERAGE_CELL_MILLIMETER)
+#define COVERAGE_CELL_MILLIMETER        200 // Should be around the width of the car
+#endif
+#if !defined(COVERAGE_MAX_CELLS_X)
+#define COVERAGE_MAX_CELLS_X             16 // Cells along the lanes
+#endif
+#if !defined(COVERAGE_MAX_CELLS_Y)
+#define COVERAGE_MAX_CELLS_Y             16 // Number of lanes
+#endif
+#if !defined(COVERAGE_OBSTACLE_CENTIMETER)
+#define COVERAGE_OBSTACLE_CENTIMETER     25 // A forward distance below this value marks the cell in front of the car as blocked
+#endif
+#if !defined(COVERAGE_MAX_ROUTE_WAYPOINTS)
+#define COVERAGE_MAX_ROUTE_WAYPOINTS      8 // Corners of the route to the next target. Longer routes are continued when the last one is reached
+#endif
+#define COVERAGE_NUMBER_OF_CELLS    (COVERAGE_MAX_CELLS_X * COVERAGE_MAX_CELLS_Y) // Planning requires this number of bytes on stack
+#define COVERAGE_CELL_UNREACHABLE   0xFF
+#define COVERAGE_BITMAP_SIZE    (((COVERAGE_MAX_CELLS_X * COVERAGE_MAX_CELLS_Y) + 7) / 8) // 32 bytes for 16 x 16 cells
+
+#if COVERAGE_NUMBER_OF_CELLS > 256
+#error Coverage area must have at most 256 cells, since cell index and cell distance are 8 bit.
+#endif
+#if (COVERAGE_MAX_CELLS_X * COVERAGE_CELL_MILLIMETER) > 16000 || (COVERAGE_MAX_CELLS_Y * COVERAGE_CELL_MILLIMETER) > 16000
+#error Coverage area must be within 16 meter, since CarPathFollower waypoints are limited to 16 meter.
+#endif
+
+class CarCoveragePlanner {
+public:
+    void start(uint8_t aNumberOfCellsX, uint8_t aNumberOfCellsY, uint8_t aSpeedPWM);
+    void stop();
+    bool update(uint8_t aForwardDistanceCentimeter); // Call it in your loop after RobotCar.updateMotors(). Returns true while covering
+    uint8_t getCoveragePercent();
+    void printCoverage(Print *aSerial);
+
+    /*
+     * Internal functions
+     */
+    bool getCellOfPoint(int32_t aXMillimeter, int32_t aYMillimeter, uint8_t *aCellX, uint8_t *aCellY);
+    bool getCurrentCell(uint8_t *aCellX, uint8_t *aCellY);
+    bool getCellAhead(int32_t aDistanceMillimeter, uint8_t *aCellX, uint8_t *aCellY);
+    bool isCellBitSet(uint8_t *aBitmap, uint8_t aCellX, uint8_t aCellY);
+    void setCellBit(uint8_t *aBitmap, uint8_t aCellX, uint8_t aCellY);
+    void clearCellBit(uint8_t *aBitmap, uint8_t aCellX, uint8_t aCellY);
+    bool isCellToVisit(uint8_t aCellX, uint8_t aCellY);
+    bool markObstacleAhead(uint8_t aForwardDistanceCentimeter);
+    void computeCellDistances(uint8_t aCellX, uint8_t aCellY, uint8_t *aDistances);
+    bool selectNextTarget();
+    void startDriveToCell(uint8_t aCellX, uint8_t aCellY, uint8_t *aDistances);
+    void addRouteWaypoint(uint8_t aCellX, uint8_t aCellY);
+
+    uint8_t NumberOfCellsX;
+    uint8_t NumberOfCellsY;
+    uint8_t SpeedPWM;
+    int8_t LaneDirection;           // +1 for driving along positive x, -1 for negative x
+    bool IsCovering;
+    bool ObstacleIsAhead;
+    CarWaypointStruct RouteWaypoints[COVERAGE_MAX_ROUTE_WAYPOINTS];
+    uint8_t NumberOfRouteWaypoints;
+    uint8_t VisitedCells[COVERAGE_BITMAP_SIZE];
+    uint8_t BlockedCells[COVERAGE_BITMAP_SIZE];
+    unsigned long StartMillis;
+};
+
+extern CarCoveragePlanner CoveragePlanner;
+
+#endif // _CAR_COVERAGE_PLANNER_H
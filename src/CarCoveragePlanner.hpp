@@ -0,0 +1,451 @@
+/*
+ * CarCoveragePlanner.hpp
+ *
+ *  Boustrophedon coverage of a rectangular area of NumberOfCellsX * NumberOfCellsY cells.
+ *  The car starts at the center of cell (0,0), lanes are along the x axis (forward) and the next lane is to the left.
+ *  The current cell is taken from the CarOdometry pose of the PathFollower and marked as visited.
+ *  The next target is the farthest unvisited cell of the free part of the current lane, then the nearest unvisited cell
+ *  of the next lane, and at last the nearest unvisited cell of the whole area, which collects the cells left behind obstacles.
+ *  Only cells reachable over not blocked cells are selected. The route to the target is computed by a breadth first search
+ *  over the grid and its corners are given as waypoints to the PathFollower.
+ *  If the forward distance is below COVERAGE_OBSTACLE_CENTIMETER, the cell in front of the car is marked as blocked,
+ *  the car stops, a new route is selected and the car does not drive forward until the obstacle is no longer ahead.
+ *  Call CoveragePlanner.printCoverage() periodically to log the coverage over time.
+ *
+ *  Usage:
+ *  #include "CarCoveragePlanner.hpp" after CarPWMMotorControl.hpp.
+ *  CoveragePlanner.start(8, 6, 120); and call CoveragePlanner.update(tForwardDistanceCentimeter) in loop after RobotCar.updateMotors().
+ *
+ *  Requires CarPWMMotorControl.hpp and USE_ENCODER_MOTOR_CONTROL
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_COVERAGE_PLANNER_HPP
+#define _CAR_COVERAGE_PLANNER_HPP
+
+#include "CarCoveragePlanner.h"
+#include "CarPathFollower.hpp"
+
+#if defined(DEBUG)
+#define LOCAL_DEBUG
+#else
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+#endif
+
+CarCoveragePlanner CoveragePlanner;
+
+/*
+ * The current pose of the car is the center of cell (0,0)
+ */
+void CarCoveragePlanner::start(uint8_t aNumberOfCellsX, uint8_t aNumberOfCellsY, uint8_t aSpeedPWM) {
+    NumberOfCellsX = min(aNumberOfCellsX, (uint8_t) COVERAGE_MAX_CELLS_X);
+    NumberOfCellsY = min(aNumberOfCellsY, (uint8_t) COVERAGE_MAX_CELLS_Y);
+    SpeedPWM = aSpeedPWM;
+    LaneDirection = 1;
+    ObstacleIsAhead = false;
+    memset(VisitedCells, 0, sizeof(VisitedCells));
+    memset(BlockedCells, 0, sizeof(BlockedCells));
+    PathFollower.Odometry.reset();
+    setCellBit(VisitedCells, 0, 0);
+    StartMillis = millis();
+    IsCovering = true;
+    selectNextTarget();
+}
+
+void CarCoveragePlanner::stop() {
+    IsCovering = false;
+    PathFollower.stop();
+}
+
+bool CarCoveragePlanner::isCellBitSet(uint8_t *aBitmap, uint8_t aCellX, uint8_t aCellY) {
+    uint16_t tBitIndex = (aCellY * NumberOfCellsX) + aCellX;
+    return aBitmap[tBitIndex / 8] & (1 << (tBitIndex % 8));
+}
+
+void CarCoveragePlanner::setCellBit(uint8_t *aBitmap, uint8_t aCellX, uint8_t aCellY) {
+    uint16_t tBitIndex = (aCellY * NumberOfCellsX) + aCellX;
+    aBitmap[tBitIndex / 8] |= (1 << (tBitIndex % 8));
+}
+
+void CarCoveragePlanner::clearCellBit(uint8_t *aBitmap, uint8_t aCellX, uint8_t aCellY) {
+    uint16_t tBitIndex = (aCellY * NumberOfCellsX) + aCellX;
+    aBitmap[tBitIndex / 8] &= ~(1 << (tBitIndex % 8));
+}
+
+bool CarCoveragePlanner::isCellToVisit(uint8_t aCellX, uint8_t aCellY) {
+    return !isCellBitSet(VisitedCells, aCellX, aCellY) && !isCellBitSet(BlockedCells, aCellX, aCellY);
+}
+
+/*
+ * @return false if point is outside of the coverage area
+ */
+bool CarCoveragePlanner::getCellOfPoint(int32_t aXMillimeter, int32_t aYMillimeter, uint8_t *aCellX, uint8_t *aCellY) {
+    // Cell centers are at multiples of COVERAGE_CELL_MILLIMETER
+    aXMillimeter += COVERAGE_CELL_MILLIMETER / 2;
+    aYMillimeter += COVERAGE_CELL_MILLIMETER / 2;
+    if (aXMillimeter < 0 || aYMillimeter < 0) {
+        return false;
+    }
+    uint16_t tCellX = aXMillimeter / COVERAGE_CELL_MILLIMETER;
+    uint16_t tCellY = aYMillimeter / COVERAGE_CELL_MILLIMETER;
+    if (tCellX >= NumberOfCellsX || tCellY >= NumberOfCellsY) {
+        return false;
+    }
+    *aCellX = tCellX;
+    *aCellY = tCellY;
+    return true;
+}
+
+/*
+ * If the car is outside of the coverage area, the nearest cell is returned
+ * @return false if car is outside of the coverage area
+ */
+bool CarCoveragePlanner::getCurrentCell(uint8_t *aCellX, uint8_t *aCellY) {
+    int32_t tXMillimeter = PathFollower.Odometry.getXMillimeter();
+    int32_t tYMillimeter = PathFollower.Odometry.getYMillimeter();
+    if (getCellOfPoint(tXMillimeter, tYMillimeter, aCellX, aCellY)) {
+        return true;
+    }
+    tXMillimeter = constrain(tXMillimeter, 0, (int32_t) (NumberOfCellsX - 1) * COVERAGE_CELL_MILLIMETER);
+    tYMillimeter = constrain(tYMillimeter, 0, (int32_t) (NumberOfCellsY - 1) * COVERAGE_CELL_MILLIMETER);
+    getCellOfPoint(tXMillimeter, tYMillimeter, aCellX, aCellY);
+    return false;
+}
+
+/*
+ * @return false if the point at aDistanceMillimeter in front of the car is outside of the coverage area
+ */
+bool CarCoveragePlanner::getCellAhead(int32_t aDistanceMillimeter, uint8_t *aCellX, uint8_t *aCellY) {
+    CarOdometry *tOdometry = &PathFollower.Odometry;
+    return getCellOfPoint(tOdometry->getXMillimeter() + ((aDistanceMillimeter * getCosineQ14(tOdometry->HeadingBinaryAngle)) >> 14),
+            tOdometry->getYMillimeter() + ((aDistanceMillimeter * getSineQ14(tOdometry->HeadingBinaryAngle)) >> 14), aCellX,
+            aCellY);
+}
+
+/*
+ * Marks the cell at the measured distance in front of the car as blocked.
+ * If this point is outside of the coverage area, e.g. at the wall at the end of the lane, the last cell of the area
+ * in front of the car is blocked, since the car cannot reach it.
+ * @return true if a cell, which was not blocked before, was blocked
+ */
+bool CarCoveragePlanner::markObstacleAhead(uint8_t aForwardDistanceCentimeter) {
+    if (aForwardDistanceCentimeter == 0 || aForwardDistanceCentimeter >= COVERAGE_OBSTACLE_CENTIMETER) {
+        return false; // 0 is timeout or no measurement
+    }
+    uint8_t tCurrentCellX, tCurrentCellY;
+    getCurrentCell(&tCurrentCellX, &tCurrentCellY);
+
+    // Take a point slightly behind the obstacle surface, but never the cell we are in
+    int32_t tDistanceMillimeter = (aForwardDistanceCentimeter * 10) + (COVERAGE_CELL_MILLIMETER / 4);
+    uint8_t tCellX, tCellY;
+    bool tIsInArea;
+    while ((tIsInArea = getCellAhead(tDistanceMillimeter, &tCellX, &tCellY)) && tCellX == tCurrentCellX
+            && tCellY == tCurrentCellY) {
+        tDistanceMillimeter += COVERAGE_CELL_MILLIMETER / 2;
+    }
+    if (!tIsInArea) {
+        /*
+         * Obstacle is outside of the coverage area, e.g. the wall at the end of the lane.
+         * Take the last cell of the area in front of the car.
+         */
+        do {
+            tDistanceMillimeter -= COVERAGE_CELL_MILLIMETER / 4;
+            if (tDistanceMillimeter <= 0) {
+                return false;
+            }
+        } while (!getCellAhead(tDistanceMillimeter, &tCellX, &tCellY));
+        if (tCellX == tCurrentCellX && tCellY == tCurrentCellY) {
+            return false; // we are at the border and facing outwards
+        }
+    }
+    if (isCellBitSet(BlockedCells, tCellX, tCellY)) {
+        return false;
+    }
+    setCellBit(BlockedCells, tCellX, tCellY);
+#if defined(LOCAL_DEBUG)
+    Serial.print(F("Blocked cell x="));
+    Serial.print(tCellX);
+    Serial.print(F(" y="));
+    Serial.println(tCellY);
+#endif
+    return true;
+}
+
+static const int8_t sCellNeighborDeltaX[4] = { 1, 0, -1, 0 };
+static const int8_t sCellNeighborDeltaY[4] = { 0, 1, 0, -1 };
+
+/*
+ * Breadth first search over the not blocked cells, implemented as wavefront to require no queue.
+ * @param aDistances Array of NumberOfCellsX * NumberOfCellsY bytes, filled with number of cells to drive from aCellX, aCellY
+ *                   or COVERAGE_CELL_UNREACHABLE
+ */
+void CarCoveragePlanner::computeCellDistances(uint8_t aCellX, uint8_t aCellY, uint8_t *aDistances) {
+    memset(aDistances, COVERAGE_CELL_UNREACHABLE, NumberOfCellsX * NumberOfCellsY);
+    aDistances[(aCellY * NumberOfCellsX) + aCellX] = 0;
+    uint8_t tDistance = 0;
+    bool tCellWasReached;
+    do {
+        tCellWasReached = false;
+        for (uint8_t y = 0; y < NumberOfCellsY; ++y) {
+            for (uint8_t x = 0; x < NumberOfCellsX; ++x) {
+                if (aDistances[(y * NumberOfCellsX) + x] != tDistance) {
+                    continue;
+                }
+                for (uint_fast8_t i = 0; i < 4; ++i) {
+                    int tNeighborX = x + sCellNeighborDeltaX[i];
+                    int tNeighborY = y + sCellNeighborDeltaY[i];
+                    if (tNeighborX >= 0 && tNeighborX < NumberOfCellsX && tNeighborY >= 0 && tNeighborY < NumberOfCellsY
+                            && aDistances[(tNeighborY * NumberOfCellsX) + tNeighborX] == COVERAGE_CELL_UNREACHABLE
+                            && !isCellBitSet(BlockedCells, tNeighborX, tNeighborY)) {
+                        aDistances[(tNeighborY * NumberOfCellsX) + tNeighborX] = tDistance + 1;
+                        tCellWasReached = true;
+                    }
+                }
+            }
+        }
+        tDistance++;
+    } while (tCellWasReached && tDistance < COVERAGE_CELL_UNREACHABLE - 1);
+}
+
+void CarCoveragePlanner::addRouteWaypoint(uint8_t aCellX, uint8_t aCellY) {
+    RouteWaypoints[NumberOfRouteWaypoints].XMillimeter = aCellX * COVERAGE_CELL_MILLIMETER;
+    RouteWaypoints[NumberOfRouteWaypoints].YMillimeter = aCellY * COVERAGE_CELL_MILLIMETER;
+    NumberOfRouteWaypoints++;
+}
+
+/*
+ * Computes the shortest route over not blocked cells from the current cell to the target cell
+ * and starts the PathFollower with the corners of this route.
+ * If the route has more than COVERAGE_MAX_ROUTE_WAYPOINTS corners, it ends at the last corner
+ * and the rest is planned when this corner is reached.
+ * @param aDistances Array of NumberOfCellsX * NumberOfCellsY bytes used for the search
+ */
+void CarCoveragePlanner::startDriveToCell(uint8_t aCellX, uint8_t aCellY, uint8_t *aDistances) {
+#if defined(LOCAL_DEBUG)
+    Serial.print(F("Next cell x="));
+    Serial.print(aCellX);
+    Serial.print(F(" y="));
+    Serial.println(aCellY);
+#endif
+    computeCellDistances(aCellX, aCellY, aDistances);
+    uint8_t tCellX, tCellY;
+    getCurrentCell(&tCellX, &tCellY);
+    uint8_t tDistance = aDistances[(tCellY * NumberOfCellsX) + tCellX];
+
+    /*
+     * Go from the current cell to the neighbor, which is one cell nearer to the target and keep direction if possible
+     */
+    NumberOfRouteWaypoints = 0;
+    uint_fast8_t tLastDirection = 0;
+    bool tIsFirstStep = true;
+    while (tDistance != 0 && tDistance != COVERAGE_CELL_UNREACHABLE
+            && NumberOfRouteWaypoints < COVERAGE_MAX_ROUTE_WAYPOINTS - 1) {
+        uint_fast8_t tDirection = tLastDirection;
+        for (uint_fast8_t i = 0; i < 4; ++i) {
+            int tNeighborX = tCellX + sCellNeighborDeltaX[tDirection];
+            int tNeighborY = tCellY + sCellNeighborDeltaY[tDirection];
+            if (tNeighborX >= 0 && tNeighborX < NumberOfCellsX && tNeighborY >= 0 && tNeighborY < NumberOfCellsY
+                    && aDistances[(tNeighborY * NumberOfCellsX) + tNeighborX] == tDistance - 1) {
+                break;
+            }
+            tDirection = (tDirection + 1) & 0x03;
+        }
+        if (tDirection != tLastDirection && !tIsFirstStep) {
+            addRouteWaypoint(tCellX, tCellY); // corner
+        }
+        tIsFirstStep = false;
+        tLastDirection = tDirection;
+        tCellX += sCellNeighborDeltaX[tDirection];
+        tCellY += sCellNeighborDeltaY[tDirection];
+        tDistance--;
+    }
+    addRouteWaypoint(tCellX, tCellY);
+    PathFollower.startPath(RouteWaypoints, NumberOfRouteWaypoints, SpeedPWM, false);
+}
+
+/*
+ * @return false if all reachable cells are visited
+ */
+bool CarCoveragePlanner::selectNextTarget() {
+    uint8_t tCellX, tCellY;
+    getCurrentCell(&tCellX, &tCellY);
+    clearCellBit(BlockedCells, tCellX, tCellY); // We are here, so it cannot be blocked
+
+    uint8_t tDistances[COVERAGE_NUMBER_OF_CELLS];
+    computeCellDistances(tCellX, tCellY, tDistances);
+
+    /*
+     * 1. Farthest unvisited cell of the free part of the current lane, first in driving direction, then in opposite direction
+     */
+    for (uint_fast8_t i = 0; i < 2; ++i) {
+        int tTargetX = -1;
+        for (int x = tCellX + LaneDirection; x >= 0 && x < NumberOfCellsX && !isCellBitSet(BlockedCells, x, tCellY);
+                x += LaneDirection) {
+            if (!isCellBitSet(VisitedCells, x, tCellY)) {
+                tTargetX = x;
+            }
+        }
+        if (tTargetX >= 0) {
+            startDriveToCell(tTargetX, tCellY, tDistances);
+            return true;
+        }
+        LaneDirection = -LaneDirection;
+    }
+
+    /*
+     * 2. Nearest reachable unvisited cell of the next lane, which is then driven in opposite direction
+     */
+    if (tCellY + 1 < NumberOfCellsY) {
+        for (int tOffset = 0; tOffset < NumberOfCellsX; ++tOffset) {
+            int tTargetX = tCellX + tOffset;
+            if (tTargetX < NumberOfCellsX && isCellToVisit(tTargetX, tCellY + 1)
+                    && tDistances[((tCellY + 1) * NumberOfCellsX) + tTargetX] != COVERAGE_CELL_UNREACHABLE) {
+                LaneDirection = -LaneDirection;
+                startDriveToCell(tTargetX, tCellY + 1, tDistances);
+                return true;
+            }
+            tTargetX = tCellX - tOffset;
+            if (tTargetX >= 0 && isCellToVisit(tTargetX, tCellY + 1)
+                    && tDistances[((tCellY + 1) * NumberOfCellsX) + tTargetX] != COVERAGE_CELL_UNREACHABLE) {
+                LaneDirection = -LaneDirection;
+                startDriveToCell(tTargetX, tCellY + 1, tDistances);
+                return true;
+            }
+        }
+    }
+
+    /*
+     * 3. Unvisited cell of the whole area with the shortest route, cells behind obstacles are not reachable
+     */
+    uint8_t tMinDistance = COVERAGE_CELL_UNREACHABLE;
+    uint8_t tTargetX = 0;
+    uint8_t tTargetY = 0;
+    for (uint8_t y = 0; y < NumberOfCellsY; ++y) {
+        for (uint8_t x = 0; x < NumberOfCellsX; ++x) {
+            uint8_t tDistance = tDistances[(y * NumberOfCellsX) + x];
+            if (tDistance < tMinDistance && isCellToVisit(x, y)) {
+                tMinDistance = tDistance;
+                tTargetX = x;
+                tTargetY = y;
+            }
+        }
+    }
+    if (tMinDistance != COVERAGE_CELL_UNREACHABLE) {
+        startDriveToCell(tTargetX, tTargetY, tDistances);
+        return true;
+    }
+
+#if defined(LOCAL_DEBUG)
+    Serial.println(F("Coverage finished"));
+    printCoverage(&Serial);
+#endif
+    stop();
+    return false;
+}
+
+/*
+ * Marks the current cell as visited and selects a new target if the current one is reached or an obstacle was detected.
+ * While the obstacle is ahead, the car does not drive forward, but turns towards its new route.
+ * @param aForwardDistanceCentimeter Current forward distance, 0 if not available
+ * @return true while covering, false if all reachable cells are visited or coverage was stopped
+ */
+bool CarCoveragePlanner::update(uint8_t aForwardDistanceCentimeter) {
+    if (!IsCovering) {
+        return false;
+    }
+    uint8_t tCellX, tCellY;
+    if (getCurrentCell(&tCellX, &tCellY)) {
+        setCellBit(VisitedCells, tCellX, tCellY);
+    }
+    if (aForwardDistanceCentimeter != 0 && aForwardDistanceCentimeter < COVERAGE_OBSTACLE_CENTIMETER) {
+        // Replan for each new obstacle, even if its cell is already blocked
+        if (markObstacleAhead(aForwardDistanceCentimeter) || !ObstacleIsAhead) {
+            ObstacleIsAhead = true;
+            PathFollower.stop();
+            if (!selectNextTarget()) {
+                return false;
+            }
+        }
+        PathFollower.ObstacleMillimeter = aForwardDistanceCentimeter * 10;
+    } else {
+        ObstacleIsAhead = false;
+        PathFollower.ObstacleMillimeter = 0;
+    }
+    if (PathFollower.update()) {
+        return true;
+    }
+    PathFollower.stop();
+    return selectNextTarget();
+}
+
+/*
+ * @return Percentage of visited cells of all not blocked cells
+ */
+uint8_t CarCoveragePlanner::getCoveragePercent() {
+    uint16_t tFreeCells = 0;
+    uint16_t tVisitedCells = 0;
+    for (uint8_t y = 0; y < NumberOfCellsY; ++y) {
+        for (uint8_t x = 0; x < NumberOfCellsX; ++x) {
+            if (!isCellBitSet(BlockedCells, x, y)) {
+                tFreeCells++;
+                if (isCellBitSet(VisitedCells, x, y)) {
+                    tVisitedCells++;
+                }
+            }
+        }
+    }
+    if (tFreeCells == 0) {
+        return 100;
+    }
+    return (tVisitedCells * 100) / tFreeCells;
+}
+
+/*
+ * Prints the map with the last lane on top, C is car, # is blocked, * is visited and . is not yet visited.
+ * Then prints coverage and seconds since start.
+ */
+void CarCoveragePlanner::printCoverage(Print *aSerial) {
+    uint8_t tCarCellX, tCarCellY;
+    getCurrentCell(&tCarCellX, &tCarCellY);
+    for (int8_t y = NumberOfCellsY - 1; y >= 0; --y) {
+        for (uint8_t x = 0; x < NumberOfCellsX; ++x) {
+            char tCellChar = '.';
+            if (x == tCarCellX && y == tCarCellY) {
+                tCellChar = 'C';
+            } else if (isCellBitSet(BlockedCells, x, y)) {
+                tCellChar = '#';
+            } else if (isCellBitSet(VisitedCells, x, y)) {
+                tCellChar = '*';
+            }
+            aSerial->print(tCellChar);
+        }
+        aSerial->println();
+    }
+    aSerial->print(F("Coverage="));
+    aSerial->print(getCoveragePercent());
+    aSerial->print(F(" % after "));
+    aSerial->print((millis() - StartMillis) / 1000);
+    aSerial->println(F(" s"));
+}
+
+#if defined(LOCAL_DEBUG)
+#undef LOCAL_DEBUG
+#endif
+#endif // _CAR_COVERAGE_PLANNER_HPP
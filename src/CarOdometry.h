@@ -0,0 +1,79 @@
+/*
+ * CarOdometry.h
+ *
+ *  Computes the position and heading of the car from the encoder counts of both motors and optional the IMU turn angle.
+ *  All values are fixed point, no float is used.
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_ODOMETRY_H
+#define _CAR_ODOMETRY_H
+
+#include "CarPWMMotorControl.h"
+
+#if !defined(USE_ENCODER_MOTOR_CONTROL)
+#error CarOdometry requires USE_ENCODER_MOTOR_CONTROL
+#endif
+
+/*
+ * Binary angle: 0x10000 is 360 degree, positive is counterclockwise / left.
+ * uint16_t arithmetic gives the wrap around at 360 degree for free.
+ */
+#define BINARY_ANGLE_90_DEGREE      0x4000
+#define BINARY_ANGLE_180_DEGREE     0x8000
+#define BINARY_ANGLE_PER_HALF_DEGREE  91    // 65536 / 720 = 91.02
+#define SINE_Q14_ONE                16384   // 1.0 for getSineQ14()
+
+/*
+ * Heading change of differential drive is (right - left distance) / track width.
+ * Track width is MillimeterPer256DegreeInPlace * 360 / (256 * PI) -> binary angle = delta * (65536 * 256 / 720) / MillimeterPer256DegreeInPlace
+ */
+#define ODOMETRY_BINARY_ANGLE_FACTOR 23302L
+
+#if !defined(ODOMETRY_IMU_MAX_TURN_PER_UPDATE_HALF_DEGREE)
+#define ODOMETRY_IMU_MAX_TURN_PER_UPDATE_HALF_DEGREE  90 // Bigger IMU turn angle changes are assumed to be a reset by a RobotCar start function
+#endif
+
+int16_t getSineQ14(uint16_t aBinaryAngle);
+int16_t getCosineQ14(uint16_t aBinaryAngle);
+
+class CarOdometry {
+public:
+    void reset(int aXMillimeter = 0, int aYMillimeter = 0, uint16_t aHeadingBinaryAngle = 0);
+    void update(); // Call it at least every 200 ms while driving
+
+    int getXMillimeter();
+    int getYMillimeter();
+    int getHeadingDegree();
+    void printPose(Print *aSerial);
+
+    int32_t XMillimeterQ8;      // 1/256 millimeter resolution, 8 km range
+    int32_t YMillimeterQ8;
+    uint16_t HeadingBinaryAngle; // 0x10000 is 360 degree, positive is left, 0 is the direction of the positive x axis
+    int DrivenDistanceMillimeter; // Signed distance of the car center since last update()
+
+    unsigned int LastRightEncoderCount; // Free running encoder count at last update()
+    unsigned int LastLeftEncoderCount;
+#if defined(USE_MPU6050_IMU)
+    int LastIMUTurnAngleHalfDegree;
+#endif
+};
+
+#endif // _CAR_ODOMETRY_H
@@ -0,0 +1,175 @@
+/*
+ * CarOdometry.hpp
+ *
+ *  Computes the position and heading of the car from the encoder counts of both motors.
+ *  If USE_MPU6050_IMU is defined, the heading is taken from the IMU turn angle, which is much more accurate.
+ *  The free running encoder counts are used, which are not reset by the RobotCar start*() functions.
+ *
+ *  Requires CarPWMMotorControl.hpp
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_ODOMETRY_HPP
+#define _CAR_ODOMETRY_HPP
+
+#include "CarOdometry.h"
+
+#if defined(DEBUG)
+#define LOCAL_DEBUG
+#else
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+#endif
+
+/*
+ * First quadrant of sine with 64 steps. 16384 is 1.0
+ */
+const int16_t sSineQ14Table[65] PROGMEM = { 0, 402, 804, 1205, 1606, 2006, 2404, 2801, 3196, 3590, 3981, 4370, 4756, 5139, 5520,
+        5897, 6270, 6639, 7005, 7366, 7723, 8076, 8423, 8765, 9102, 9434, 9760, 10080, 10394, 10702, 11003, 11297, 11585, 11866,
+        12140, 12406, 12665, 12916, 13160, 13395, 13623, 13842, 14053, 14256, 14449, 14635, 14811, 14978, 15137, 15286, 15426, 15557,
+        15679, 15791, 15893, 15986, 16069, 16143, 16207, 16261, 16305, 16340, 16364, 16379, 16384 };
+
+/*
+ * Table lookup with linear interpolation, max error is 3/16384
+ * @param aBinaryAngle 0x10000 is 360 degree
+ * @return sine * 16384
+ */
+int16_t getSineQ14(uint16_t aBinaryAngle) {
+    uint16_t tQuadrantAngle = aBinaryAngle & (BINARY_ANGLE_90_DEGREE - 1);
+    if (aBinaryAngle & BINARY_ANGLE_90_DEGREE) {
+        // second and fourth quadrant are mirrored
+        tQuadrantAngle = BINARY_ANGLE_90_DEGREE - tQuadrantAngle;
+    }
+    uint8_t tIndex = tQuadrantAngle >> 8;
+    uint8_t tFraction = tQuadrantAngle; // lower 8 bits
+    int16_t tSine = pgm_read_word(&sSineQ14Table[tIndex]);
+    if (tFraction != 0) {
+        tSine += ((int32_t) ((int16_t) pgm_read_word(&sSineQ14Table[tIndex + 1]) - tSine) * tFraction) >> 8;
+    }
+    if (aBinaryAngle & BINARY_ANGLE_180_DEGREE) {
+        return -tSine;
+    }
+    return tSine;
+}
+
+int16_t getCosineQ14(uint16_t aBinaryAngle) {
+    return getSineQ14(aBinaryAngle + BINARY_ANGLE_90_DEGREE);
+}
+
+/*
+ * Sets the pose and takes the current encoder counts as reference
+ */
+void CarOdometry::reset(int aXMillimeter, int aYMillimeter, uint16_t aHeadingBinaryAngle) {
+    XMillimeterQ8 = (int32_t) aXMillimeter << 8;
+    YMillimeterQ8 = (int32_t) aYMillimeter << 8;
+    HeadingBinaryAngle = aHeadingBinaryAngle;
+    DrivenDistanceMillimeter = 0;
+    LastRightEncoderCount = RobotCar.rightCarMotor.getFreeRunningEncoderCount();
+    LastLeftEncoderCount = RobotCar.leftCarMotor.getFreeRunningEncoderCount();
+#if defined(USE_MPU6050_IMU)
+    LastIMUTurnAngleHalfDegree = RobotCar.CarTurnAngleHalfDegreesFromIMU;
+#endif
+}
+
+/*
+ * Returns signed millimeter * 16 driven by motor since last call. EncoderCount is unsigned, so direction is taken from CurrentDirection.
+ * The fraction is kept to avoid accumulating the truncation error of each update.
+ * The unsigned difference of the free running count is correct even at its 16 bit wrap around.
+ */
+static int getOdometryMotorDeltaMillimeterQ4(EncoderMotor *aMotor, unsigned int *aLastEncoderCount) {
+    unsigned int tEncoderCount = aMotor->getFreeRunningEncoderCount();
+    unsigned int tDeltaCount = tEncoderCount - *aLastEncoderCount;
+    *aLastEncoderCount = tEncoderCount;
+    int tDeltaMillimeterQ4 = ((uint32_t) tDeltaCount * aMotor->MillimeterPerCountQ8) >> 4;
+    if (aMotor->CurrentDirection == DIRECTION_BACKWARD) {
+        return -tDeltaMillimeterQ4;
+    }
+    return tDeltaMillimeterQ4;
+}
+
+/*
+ * Integrates the distance driven since last call along the mean heading of this interval.
+ * Call it at least every 200 ms while driving.
+ */
+void CarOdometry::update() {
+    int tRightDeltaMillimeterQ4 = getOdometryMotorDeltaMillimeterQ4(&RobotCar.rightCarMotor, &LastRightEncoderCount);
+    int tLeftDeltaMillimeterQ4 = getOdometryMotorDeltaMillimeterQ4(&RobotCar.leftCarMotor, &LastLeftEncoderCount);
+    int tDrivenDistanceMillimeterQ4 = (tRightDeltaMillimeterQ4 + tLeftDeltaMillimeterQ4) / 2;
+    DrivenDistanceMillimeter = tDrivenDistanceMillimeterQ4 / 16;
+
+#if defined(USE_MPU6050_IMU)
+    int tIMUDeltaHalfDegree = RobotCar.CarTurnAngleHalfDegreesFromIMU - LastIMUTurnAngleHalfDegree;
+    LastIMUTurnAngleHalfDegree = RobotCar.CarTurnAngleHalfDegreesFromIMU;
+    if (abs(tIMUDeltaHalfDegree) > ODOMETRY_IMU_MAX_TURN_PER_UPDATE_HALF_DEGREE) {
+        // IMU values were reset by a start function, take the current angle as delta
+        tIMUDeltaHalfDegree = RobotCar.CarTurnAngleHalfDegreesFromIMU;
+    }
+    int16_t tDeltaHeading = tIMUDeltaHalfDegree * BINARY_ANGLE_PER_HALF_DEGREE;
+#else
+    uint16_t tMillimeterPer256DegreeInPlace = RobotCar.MillimeterPer256DegreeInPlace;
+    if (tMillimeterPer256DegreeInPlace == 0) {
+        tMillimeterPer256DegreeInPlace = DEFAULT_MILLIMETER_PER_256_DEGREE_IN_PLACE;
+    }
+    int16_t tDeltaHeading = ((int32_t) (tRightDeltaMillimeterQ4 - tLeftDeltaMillimeterQ4) * ODOMETRY_BINARY_ANGLE_FACTOR)
+            / ((int32_t) tMillimeterPer256DegreeInPlace * 16);
+#endif
+
+    uint16_t tMeanHeading = HeadingBinaryAngle + (tDeltaHeading / 2);
+    HeadingBinaryAngle += tDeltaHeading;
+
+    // millimeter * 16 * Q14 >> 10 -> millimeter * Q8
+    XMillimeterQ8 += ((int32_t) tDrivenDistanceMillimeterQ4 * getCosineQ14(tMeanHeading)) >> 10;
+    YMillimeterQ8 += ((int32_t) tDrivenDistanceMillimeterQ4 * getSineQ14(tMeanHeading)) >> 10;
+
+#if defined(LOCAL_DEBUG)
+    if (tDrivenDistanceMillimeterQ4 != 0 || tDeltaHeading != 0) {
+        printPose(&Serial);
+    }
+#endif
+}
+
+int CarOdometry::getXMillimeter() {
+    return XMillimeterQ8 >> 8;
+}
+
+int CarOdometry::getYMillimeter() {
+    return YMillimeterQ8 >> 8;
+}
+
+/*
+ * @return -180 to 179 degree, positive is left
+ */
+int CarOdometry::getHeadingDegree() {
+    return ((int32_t) ((int16_t) HeadingBinaryAngle) * 360) >> 16;
+}
+
+void CarOdometry::printPose(Print *aSerial) {
+    aSerial->print(F("Pose x="));
+    aSerial->print(getXMillimeter());
+    aSerial->print(F(" y="));
+    aSerial->print(getYMillimeter());
+    aSerial->print(F(" mm heading="));
+    aSerial->print(getHeadingDegree());
+    aSerial->println(F(" degree"));
+}
+
+#if defined(LOCAL_DEBUG)
+#undef LOCAL_DEBUG
+#endif
+#endif // _CAR_ODOMETRY_HPP
@@ -61,6 +61,20 @@
 #  endif
 #endif
 
+/*
+ * For startGoArc() with encoder motors. Inner motor SpeedPWM is changed by this value for each centimeter it lags behind the arc.
+ */
+#if !defined(ARC_SYNCHRONIZE_PWM_PER_CENTIMETER)
+#define ARC_SYNCHRONIZE_PWM_PER_CENTIMETER   5
+#endif
+#define ARC_MAX_DEGREE_MILLIMETER      3600000L // 62 m of arc length, * 1144 fits in 32 bit, and wheel distances fit in 16 bit
+
+#if defined(ENABLE_BACKLASH_COMPENSATION) && defined(USE_MPU6050_IMU)
+#define BACKLASH_CALIBRATION_TURN_HALF_DEGREE   2 // IMU turn angle, which indicates that the car really moves
+#define BACKLASH_CALIBRATION_TIMEOUT_MILLIS   500
+#define BACKLASH_CALIBRATION_SETTLE_MILLIS    300
+#endif
+
 #define EEPROM_CAR_INFO_VALID_MARKER_VALUE  A5
 struct EepromCarInfoStruct {
     EepromMotorInfoStruct rightMotorInfo;
@@ -72,6 +86,19 @@ struct EepromCarInfoStruct {
     uint8_t ValidMarker; // must be A5
 };
 
+#if defined(USE_ENCODER_MOTOR_CONTROL)
+/*
+ * Stored separately at the end of EEPROM, to keep the layout of EepromCarInfoStruct and the route behind it valid
+ */
+#define EEPROM_ENCODER_CALIBRATION_VALID_MARKER_VALUE   0xC5
+#define EEPROM_ENCODER_CALIBRATION_ADDRESS  (E2END + 1 - sizeof(EepromEncoderCalibrationStruct))
+struct EepromEncoderCalibrationStruct {
+    uint16_t RightMillimeterPerCountQ8;
+    uint16_t LeftMillimeterPerCountQ8;
+    uint8_t ValidMarker; // must be 0xC5
+};
+#endif
+
 // turn directions
 typedef enum turn_direction {
     TURN_IN_PLACE = DIRECTION_STOP, TURN_FORWARD = DIRECTION_FORWARD, TURN_BACKWARD = DIRECTION_BACKWARD
@@ -112,6 +139,11 @@ public:
 #if defined(USE_MPU6050_IMU)
     void updateIMUData();
     void calculateAndPrintIMUOffsets(Print *aSerial);
+#  if defined(ENABLE_BACKLASH_COMPENSATION)
+    void calibrateBacklashWithIMU();
+    uint8_t calibrateBacklashWithIMU(PWMDcMotor *aMotor);
+    unsigned int getMillisUntilIMUTurn(PWMDcMotor *aMotor, uint8_t aRequestedDirection);
+#  endif
 #endif
 
 #if defined(USE_ENCODER_MOTOR_CONTROL)
@@ -167,8 +199,25 @@ public:
     uint16_t MillimeterPer256Degree; // Use value for 256 degree to have a better resolution and faster division
     uint16_t MillimeterPer256DegreeInPlace;
 
+    /*
+     * Functions for driving an arc
+     */
+    void startGoArc(unsigned int aRadiusMillimeter, int aArcDegrees, uint8_t aRequestedSpeedPWM,
+            uint8_t aRequestedDirection = DIRECTION_FORWARD);
+    void goArc(unsigned int aRadiusMillimeter, int aArcDegrees, uint8_t aRequestedSpeedPWM,
+            uint8_t aRequestedDirection = DIRECTION_FORWARD, void (*aLoopCallback)(void) = NULL); // Blocking function, uses waitUntilStopped
+    void synchronizeArcMotors();
+
+    bool ArcIsActive;           // Reset by stop(), startGoDistanceMillimeterWithSpeed() and startRotate()
+    bool ArcRightMotorIsOuter;
+    uint8_t ArcOuterSpeedPWM;
+    uint8_t ArcInnerSpeedPWM;   // Base SpeedPWM of inner motor. Modified by synchronizeArcMotors() to keep the distance ratio
+
     bool readCarValuesFromEeprom();
     void writeCarValuesToEeprom();
+#if defined(E2END) && defined(USE_ENCODER_MOTOR_CONTROL)
+    bool readEncoderCalibrationFromEeprom();
+#endif
     void printCalibrationValues(Print *aSerial);
 
 #if defined(USE_MPU6050_IMU)
@@ -214,6 +263,9 @@ public:
     void setSpeedPWMWithDeltaAndDirection(uint8_t aRequestedSpeedPWM, uint8_t aRequestedDirection,
             int8_t aSpeedPWMCompensationRightDelta);
     void changeSpeedPWM(uint8_t aRequestedSpeedPWM); // Keeps direction
+    void setSpeedPWMAndDirectionSmooth(int aSignedRequestedSpeedPWM); // No stop at direction change, requires updateMotors()
+    void setSpeedPWMSmooth(int aSignedRequestedSpeedPWMForLeftMotor, int aSignedRequestedSpeedPWMForRightMotor);
+    void setBlendAccelerationAndDeceleration(uint8_t aAccelerationValueDelta, uint8_t aDecelerationValueDelta);
 
     void stop(uint8_t aStopMode = STOP_MODE_KEEP); // STOP_MODE_KEEP (take previously defined DefaultStopMode) or STOP_MODE_BRAKE or STOP_MODE_RELEASE
     void setStopMode(uint8_t aStopMode);
@@ -230,5 +282,15 @@ public:
 #if !defined(CAR_HAS_4_MECANUM_WHEELS)
 extern CarPWMMotorControl RobotCar;
 #endif
+#if defined(USE_MPU6050_IMU) && defined(ENABLE_IMU_EVENT_DETECTION)
+void stopRobotCarOnIMUEvent(uint8_t aNewEvents);
+#endif
+
+#if defined(ENABLE_ROUTE_RECORDING)
+#include "CarRouteRecorder.h"
+#endif
+#if defined(ENABLE_POWER_MANAGEMENT)
+#include "CarPowerManager.h"
+#endif
 
 #endif // _CAR_PWM_MOTOR_CONTROL_H
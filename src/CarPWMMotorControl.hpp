@@ -152,6 +152,10 @@ void CarPWMMotorControl::setDefaultsForFixedDistanceDriving() {
     MillimeterPer256DegreeInPlace = DEFAULT_MILLIMETER_PER_256_DEGREE_IN_PLACE;
     rightCarMotor.setDefaultsForFixedDistanceDriving();
     leftCarMotor.setDefaultsForFixedDistanceDriving();
+#if defined(USE_ENCODER_MOTOR_CONTROL)
+    rightCarMotor.MillimeterPerCountQ8 = FACTOR_COUNT_TO_MILLIMETER_Q8_DEFAULT;
+    leftCarMotor.MillimeterPerCountQ8 = FACTOR_COUNT_TO_MILLIMETER_Q8_DEFAULT;
+#endif
 }
 
 /**
@@ -340,6 +344,32 @@ void CarPWMMotorControl::setSpeedPWMAndDirection(int aSignedRequestedSpeedPWM) {
     leftCarMotor.setSpeedPWMAndDirection(aSignedRequestedSpeedPWM, tDirection);
 }
 
+/*
+ * Rate limited speed change of both motors, also through zero, without stop() and delay() of checkAndHandleDirectionChange().
+ * Blending is done by updateMotors(), which must be called in loop.
+ */
+void CarPWMMotorControl::setSpeedPWMAndDirectionSmooth(int aSignedRequestedSpeedPWM) {
+    if (aSignedRequestedSpeedPWM == 0) {
+        CarDirection = DIRECTION_STOP;
+    } else if (aSignedRequestedSpeedPWM < 0) {
+        CarDirection = DIRECTION_BACKWARD;
+    } else {
+        CarDirection = DIRECTION_FORWARD;
+    }
+    rightCarMotor.setSpeedPWMAndDirectionSmooth(aSignedRequestedSpeedPWM);
+    leftCarMotor.setSpeedPWMAndDirectionSmooth(aSignedRequestedSpeedPWM);
+}
+
+void CarPWMMotorControl::setSpeedPWMSmooth(int aSignedRequestedSpeedPWMForLeftMotor, int aSignedRequestedSpeedPWMForRightMotor) {
+    rightCarMotor.setSpeedPWMAndDirectionSmooth(aSignedRequestedSpeedPWMForRightMotor);
+    leftCarMotor.setSpeedPWMAndDirectionSmooth(aSignedRequestedSpeedPWMForLeftMotor);
+}
+
+void CarPWMMotorControl::setBlendAccelerationAndDeceleration(uint8_t aAccelerationValueDelta, uint8_t aDecelerationValueDelta) {
+    rightCarMotor.setBlendAccelerationAndDeceleration(aAccelerationValueDelta, aDecelerationValueDelta);
+    leftCarMotor.setBlendAccelerationAndDeceleration(aAccelerationValueDelta, aDecelerationValueDelta);
+}
+
 uint8_t CarPWMMotorControl::getCarDirection() {
     return CarDirection;
 }
@@ -352,6 +382,7 @@ void CarPWMMotorControl::stop(uint8_t aStopMode) {
     rightCarMotor.stop(aStopMode);
     leftCarMotor.stop(aStopMode);
     CarDirection = DIRECTION_STOP;
+    ArcIsActive = false;
 }
 
 /*
@@ -392,6 +423,73 @@ void CarPWMMotorControl::updateIMUData() {
         }
     }
 }
+
+#  if defined(ENABLE_BACKLASH_COMPENSATION)
+/*
+ * Determines BacklashTakeUpMillis for both motors. The car turns a few degree around each wheel.
+ */
+void CarPWMMotorControl::calibrateBacklashWithIMU() {
+    rightCarMotor.setBacklashTakeUpMillis(calibrateBacklashWithIMU(&rightCarMotor));
+    leftCarMotor.setBacklashTakeUpMillis(calibrateBacklashWithIMU(&leftCarMotor));
+}
+
+/*
+ * Only one motor is running, so the car turns around the other wheel and the IMU detects the start of movement by the turn angle.
+ * The time from start of motor until movement is measured once after a start in the same direction,
+ * i.e. with closed gear play, and once after a direction reversal. The difference is the time required to take up the backlash.
+ * @return Millis for the take up pulse with BACKLASH_TAKE_UP_SPEED_PWM
+ */
+uint8_t CarPWMMotorControl::calibrateBacklashWithIMU(PWMDcMotor *aMotor) {
+    aMotor->setBacklashTakeUpMillis(0); // Disable compensation while measuring
+    getMillisUntilIMUTurn(aMotor, DIRECTION_FORWARD); // Closes gear play for forward direction
+    unsigned int tMillisWithoutBacklash = getMillisUntilIMUTurn(aMotor, DIRECTION_FORWARD);
+    unsigned int tMillisWithBacklash = getMillisUntilIMUTurn(aMotor, DIRECTION_BACKWARD);
+    getMillisUntilIMUTurn(aMotor, DIRECTION_BACKWARD); // Go back to start position
+#if defined(LOCAL_DEBUG)
+    Serial.print(F("Millis until turn without backlash="));
+    Serial.print(tMillisWithoutBacklash);
+    Serial.print(F(" with backlash="));
+    Serial.println(tMillisWithBacklash);
+#endif
+    if (tMillisWithBacklash <= tMillisWithoutBacklash) {
+        return 0;
+    }
+    tMillisWithBacklash -= tMillisWithoutBacklash;
+    if (tMillisWithBacklash > BACKLASH_MAX_TAKE_UP_MILLIS) {
+        tMillisWithBacklash = BACKLASH_MAX_TAKE_UP_MILLIS;
+    }
+    return tMillisWithBacklash;
+}
+
+/*
+ * Motor is stopped with STOP_MODE_RELEASE, to keep the gear play closed in the driving direction
+ * @return Millis from start of motor with BACKLASH_TAKE_UP_SPEED_PWM until the IMU detects a turn
+ */
+unsigned int CarPWMMotorControl::getMillisUntilIMUTurn(PWMDcMotor *aMotor, uint8_t aRequestedDirection) {
+    IMUData.resetOffsetFifoAndCarDataAndWait(); // Car must be at rest here, this also resets turn angle
+    unsigned long tStartMillis = millis();
+    aMotor->setSpeedPWMAndDirection(BACKLASH_TAKE_UP_SPEED_PWM, aRequestedDirection);
+    while (abs(IMUData.getTurnAngleHalfDegree()) < BACKLASH_CALIBRATION_TURN_HALF_DEGREE
+            && millis() - tStartMillis < BACKLASH_CALIBRATION_TIMEOUT_MILLIS) {
+        IMUData.readCarDataFromMPU6050Fifo();
+    }
+    unsigned int tMillisUntilTurn = millis() - tStartMillis;
+    aMotor->stop(STOP_MODE_RELEASE);
+    delay(BACKLASH_CALIBRATION_SETTLE_MILLIS);
+    return tMillisUntilTurn;
+}
+#  endif // defined(ENABLE_BACKLASH_COMPENSATION)
+
+#  if defined(ENABLE_IMU_EVENT_DETECTION)
+/*
+ * Assign it to RobotCar.IMUData.EventCallback to brake the car within the FIFO read, in which the event was detected.
+ * This is about 1 ms after the collision, if updateIMUData() is called in every loop.
+ */
+void stopRobotCarOnIMUEvent(uint8_t aNewEvents) {
+    (void) aNewEvents;
+    RobotCar.stop(STOP_MODE_BRAKE);
+}
+#  endif
 #endif
 
 /*
@@ -408,6 +506,11 @@ void CarPWMMotorControl::updateIMUData() {
  */
 bool CarPWMMotorControl::updateMotors() {
 #if defined(USE_MPU6050_IMU)
+#  if defined(ENABLE_BACKLASH_COMPENSATION)
+            // Required, since updateMotor() is not called while rotating with IMU
+            rightCarMotor.checkBacklashTakeUp();
+            leftCarMotor.checkBacklashTakeUp();
+#  endif
             bool tReturnValue = !isStopped();
             updateIMUData();
             if (CarRequestedRotationDegrees != 0) {
@@ -434,7 +537,18 @@ bool CarPWMMotorControl::updateMotors() {
                     /*
                      * Reduce SpeedPWM just before target angle is reached. If motors are not stopped, we run for extra 2 to 4 degree
                      */
-                    changeSpeedPWM(rightCarMotor.DriveSpeedPWMFor2Volt / 2);
+                    if (ArcIsActive) {
+                        // Keep the speed ratio of the arc
+                        if (ArcRightMotorIsOuter) {
+                            rightCarMotor.changeSpeedPWM(ArcOuterSpeedPWM / 2);
+                            leftCarMotor.changeSpeedPWM(ArcInnerSpeedPWM / 2);
+                        } else {
+                            leftCarMotor.changeSpeedPWM(ArcOuterSpeedPWM / 2);
+                            rightCarMotor.changeSpeedPWM(ArcInnerSpeedPWM / 2);
+                        }
+                    } else {
+                        changeSpeedPWM(rightCarMotor.DriveSpeedPWMFor2Volt / 2);
+                    }
                 }
             } else {
                 /*
@@ -488,6 +602,7 @@ bool CarPWMMotorControl::updateMotors() {
 #else // USE_MPU6050_IMU
     bool tReturnValue = rightCarMotor.updateMotor();
     tReturnValue |= leftCarMotor.updateMotor();
+    synchronizeArcMotors();
 #endif // USE_MPU6050_IMU
 
     return tReturnValue;;
@@ -566,6 +681,15 @@ void CarPWMMotorControl::startGoDistanceMillimeter(uint8_t aRequestedSpeedPWM, u
 void CarPWMMotorControl::startGoDistanceMillimeterWithSpeed(uint8_t aRequestedSpeedPWM, unsigned int aRequestedDistanceMillimeter,
         uint8_t aRequestedDirection) {
 
+    ArcIsActive = false;
+
+#if defined(ENABLE_ROUTE_RECORDING)
+    // Must be done before IMU and encoder values are reset
+    RouteRecorder.recordStep(ROUTE_STEP_GO,
+            (aRequestedDirection == DIRECTION_BACKWARD) ? -(int) aRequestedDistanceMillimeter : (int) aRequestedDistanceMillimeter,
+            aRequestedSpeedPWM);
+#endif
+
 #if defined(USE_MPU6050_IMU)
             IMUData.resetAllIMUCarOffsetAdjustedValues();
             CarRequestedDistanceMillimeter = aRequestedDistanceMillimeter;
@@ -723,6 +847,12 @@ void CarPWMMotorControl::startRotate(int aRotationDegrees, turn_direction_t aTur
         Serial.flush();
 #endif
 
+    ArcIsActive = false;
+
+#if defined(ENABLE_ROUTE_RECORDING)
+    RouteRecorder.recordStep(aTurnDirection, aRotationDegrees, aUseSlowSpeed);
+#endif
+
 #if defined(USE_MPU6050_IMU)
         IMUData.resetAllIMUCarOffsetAdjustedValues();
         CarRequestedRotationDegrees = aRotationDegrees;
@@ -834,6 +964,171 @@ void CarPWMMotorControl::rotate(int aRotationDegrees, turn_direction_t aTurnDire
     }
 }
 
+/**
+ * Drive on a circular arc by driving both wheels with the distance and speed ratio of the arc.
+ * Without IMU, the arc ends if both motors have driven their distance, with IMU it ends if the requested heading is reached.
+ * For encoder motors the SpeedPWM of the inner motor is adjusted by synchronizeArcMotors() to keep the distance ratio.
+ * @param  aRadiusMillimeter Radius of the path of the car center. If less than the half track width, the inner wheel runs backwards.
+ * @param  aArcDegrees positive -> turn left (counterclockwise), negative -> turn right
+ *         |aArcDegrees| * aRadiusMillimeter is clipped at ARC_MAX_DEGREE_MILLIMETER, which is 62 m of arc length.
+ * @param  aRequestedSpeedPWM SpeedPWM of the outer wheel
+ * @param  aRequestedDirection DIRECTION_FORWARD or DIRECTION_BACKWARD
+ */
+void CarPWMMotorControl::startGoArc(unsigned int aRadiusMillimeter, int aArcDegrees, uint8_t aRequestedSpeedPWM,
+        uint8_t aRequestedDirection) {
+    if (aArcDegrees == 0) {
+        return;
+    }
+    checkAndHandleDirectionChange(aRequestedDirection);
+
+#if defined(ENABLE_ROUTE_RECORDING)
+    RouteRecorder.finishPendingStep(); // Arcs are not recorded
+#endif
+#if defined(USE_MPU6050_IMU)
+    IMUData.resetAllIMUCarOffsetAdjustedValues();
+    CarRequestedRotationDegrees = aArcDegrees;
+#endif
+
+    /*
+     * Turning left forward or right backward, the right wheel is the outer one
+     */
+    bool tTurnLeft = (aArcDegrees > 0);
+    if (!tTurnLeft) {
+        aArcDegrees = -aArcDegrees;
+    }
+    ArcRightMotorIsOuter = (tTurnLeft == (aRequestedDirection == DIRECTION_FORWARD));
+#if defined(USE_ENCODER_MOTOR_CONTROL)
+    EncoderMotor *tOuterMotor;
+    EncoderMotor *tInnerMotor;
+#else
+    PWMDcMotor *tOuterMotor;
+    PWMDcMotor *tInnerMotor;
+#endif
+    if (ArcRightMotorIsOuter) {
+        tOuterMotor = &rightCarMotor;
+        tInnerMotor = &leftCarMotor;
+    } else {
+        tOuterMotor = &leftCarMotor;
+        tInnerMotor = &rightCarMotor;
+    }
+
+    /*
+     * Distance of car center is aArcDegrees * PI / 180 * aRadiusMillimeter. 1144 / 65536 is 0.017456 instead of 0.017453.
+     * Half of the track width is taken from the in place rotation value, which also covers the slip of 4WD cars.
+     */
+    uint16_t tMillimeterPer256DegreeInPlace = MillimeterPer256DegreeInPlace;
+    if (tMillimeterPer256DegreeInPlace == 0) {
+        tMillimeterPer256DegreeInPlace = DEFAULT_MILLIMETER_PER_256_DEGREE_IN_PLACE; // For IMU cars, where value is not initialized
+    }
+    uint32_t tDegreeMillimeter = (uint32_t) aArcDegrees * aRadiusMillimeter;
+    if (tDegreeMillimeter > ARC_MAX_DEGREE_MILLIMETER) {
+        tDegreeMillimeter = ARC_MAX_DEGREE_MILLIMETER; // avoid overflow of 32 bit product and of 16 bit distance
+    }
+    int32_t tCenterDistanceMillimeter = (tDegreeMillimeter * 1144) >> 16;
+    int32_t tHalfTrackDistanceMillimeter = ((int32_t) aArcDegrees * tMillimeterPer256DegreeInPlace) / 256;
+    int32_t tOuterDistanceMillimeter = tCenterDistanceMillimeter + tHalfTrackDistanceMillimeter;
+    int32_t tInnerDistanceMillimeter = tCenterDistanceMillimeter - tHalfTrackDistanceMillimeter;
+    uint8_t tInnerDirection = aRequestedDirection;
+    if (tInnerDistanceMillimeter < 0) {
+        tInnerDistanceMillimeter = -tInnerDistanceMillimeter;
+        tInnerDirection = oppositeDIRECTION(aRequestedDirection);
+    }
+    ArcOuterSpeedPWM = aRequestedSpeedPWM;
+    /*
+     * Speed is not proportional to PWM, since the motor starts turning only at DEFAULT_START_SPEED_PWM.
+     * So scale only the PWM above DEFAULT_START_SPEED_PWM, otherwise the inner motor stalls for small radii.
+     */
+    ArcInnerSpeedPWM = 0;
+    if (tInnerDistanceMillimeter != 0) {
+        if (aRequestedSpeedPWM > DEFAULT_START_SPEED_PWM) {
+            ArcInnerSpeedPWM = DEFAULT_START_SPEED_PWM
+                    + ((aRequestedSpeedPWM - DEFAULT_START_SPEED_PWM) * tInnerDistanceMillimeter) / tOuterDistanceMillimeter;
+        } else {
+            ArcInnerSpeedPWM = aRequestedSpeedPWM;
+        }
+    }
+
+#if defined(LOCAL_DEBUG)
+    Serial.print(F("Arc outer="));
+    Serial.print(tOuterDistanceMillimeter);
+    Serial.print(F(" mm inner="));
+    Serial.print(tInnerDistanceMillimeter);
+    Serial.print(F(" mm InnerSpeedPWM="));
+    Serial.println(ArcInnerSpeedPWM);
+#endif
+
+#if defined(USE_MPU6050_IMU)
+    // Like rotation, we do not have ramps here and stop at the requested heading
+    tOuterMotor->setSpeedPWMAndDirection(ArcOuterSpeedPWM, aRequestedDirection);
+    tInnerMotor->setSpeedPWMAndDirection(ArcInnerSpeedPWM, tInnerDirection);
+#else
+    tOuterMotor->startGoDistanceMillimeterWithSpeed(ArcOuterSpeedPWM, (unsigned int) tOuterDistanceMillimeter, aRequestedDirection);
+    tInnerMotor->startGoDistanceMillimeterWithSpeed(ArcInnerSpeedPWM, (unsigned int) tInnerDistanceMillimeter, tInnerDirection);
+#endif
+    ArcIsActive = true;
+}
+
+void CarPWMMotorControl::goArc(unsigned int aRadiusMillimeter, int aArcDegrees, uint8_t aRequestedSpeedPWM,
+        uint8_t aRequestedDirection, void (*aLoopCallback)(void)) {
+    startGoArc(aRadiusMillimeter, aArcDegrees, aRequestedSpeedPWM, aRequestedDirection);
+    waitUntilStopped(aLoopCallback);
+}
+
+/*
+ * Called by updateMotors(). Keeps the distance ratio of inner and outer motor while driving an arc with encoder motors,
+ * since the motor speed is not proportional to the SpeedPWM.
+ * For non encoder motors the arc is ended if both motors have stopped.
+ */
+void CarPWMMotorControl::synchronizeArcMotors() {
+    if (!ArcIsActive) {
+        return;
+    }
+#if defined(USE_ENCODER_MOTOR_CONTROL)
+    EncoderMotor *tOuterMotor;
+    EncoderMotor *tInnerMotor;
+#else
+    PWMDcMotor *tOuterMotor;
+    PWMDcMotor *tInnerMotor;
+#endif
+    if (ArcRightMotorIsOuter) {
+        tOuterMotor = &rightCarMotor;
+        tInnerMotor = &leftCarMotor;
+    } else {
+        tOuterMotor = &leftCarMotor;
+        tInnerMotor = &rightCarMotor;
+    }
+#if !defined(DO_NOT_SUPPORT_RAMP)
+    if (tOuterMotor->MotorRampState == MOTOR_STATE_START || tInnerMotor->MotorRampState == MOTOR_STATE_START) {
+        return; // Not yet started
+    }
+#endif
+    if (tOuterMotor->isStopped() && tInnerMotor->isStopped()) {
+        ArcIsActive = false;
+        return;
+    }
+#if defined(USE_ENCODER_MOTOR_CONTROL) && !defined(USE_MPU6050_IMU)
+#  if !defined(DO_NOT_SUPPORT_RAMP)
+    if (tOuterMotor->MotorRampState != MOTOR_STATE_DRIVE || tInnerMotor->MotorRampState != MOTOR_STATE_DRIVE) {
+        return; // Do not disturb ramps
+    }
+#  else
+    if (tOuterMotor->isStopped() || tInnerMotor->isStopped()) {
+        return;
+    }
+#  endif
+    /*
+     * Compare inner distance with the distance the inner motor should have at the current distance of the outer motor
+     */
+    int tLagMillimeter = (((uint32_t) tOuterMotor->getDistanceMillimeter() * tInnerMotor->TargetDistanceMillimeter)
+            / tOuterMotor->TargetDistanceMillimeter) - tInnerMotor->getDistanceMillimeter();
+    int tNewSpeedPWM = ArcInnerSpeedPWM + ((tLagMillimeter * ARC_SYNCHRONIZE_PWM_PER_CENTIMETER) / MILLIMETER_IN_ONE_CENTIMETER);
+    tNewSpeedPWM = constrain(tNewSpeedPWM, 0, (int ) MAX_SPEED_PWM);
+    if (tInnerMotor->RequestedSpeedPWM != tNewSpeedPWM) {
+        tInnerMotor->changeSpeedPWM(tNewSpeedPWM);
+    }
+#endif
+}
+
 #if defined(USE_ENCODER_MOTOR_CONTROL)
     /*
      * Get count / distance value from right motor
@@ -996,6 +1291,7 @@ bool CarPWMMotorControl::readCarValuesFromEeprom() {
 #    endif
     Serial.println();
 #  endif
+    bool tCarValuesAreValid = false;
     if (tEepromCarInfo.ValidMarker == EEPROM_CAR_INFO_VALID_MARKER_VALUE
             && rightCarMotor.readMotorValuesFromInfoStructure(&tEepromCarInfo.rightMotorInfo)
             && leftCarMotor.readMotorValuesFromInfoStructure(&tEepromCarInfo.leftMotorInfo)
@@ -1008,10 +1304,15 @@ bool CarPWMMotorControl::readCarValuesFromEeprom() {
         MillimeterPer256Degree = tEepromCarInfo.MillimeterPer256Degree;
         MillimeterPer256DegreeInPlace = tEepromCarInfo.MillimeterPer256DegreeInPlace;
 #  endif
-        return true;
+        tCarValuesAreValid = true;
     } else {
         setDefaultsForFixedDistanceDriving();
     }
+#  if defined(USE_ENCODER_MOTOR_CONTROL)
+    // Has its own marker, so it is valid even if the other values are not, and vice versa
+    readEncoderCalibrationFromEeprom();
+#  endif
+    return tCarValuesAreValid;
 #else
     MillimeterPer256Degree = DEFAULT_MILLIMETER_PER_256_DEGREE;
     MillimeterPer256DegreeInPlace = DEFAULT_MILLIMETER_PER_256_DEGREE_IN_PLACE;
@@ -1031,10 +1332,57 @@ void CarPWMMotorControl::writeCarValuesToEeprom() {
     tEepromCarInfo.ValidMarker = EEPROM_CAR_INFO_VALID_MARKER_VALUE;
 
     eeprom_write_block((void*) &tEepromCarInfo, 0, sizeof(EepromCarInfoStruct));
+
+#  if defined(USE_ENCODER_MOTOR_CONTROL)
+    EepromEncoderCalibrationStruct tEepromEncoderCalibration;
+    tEepromEncoderCalibration.RightMillimeterPerCountQ8 = rightCarMotor.MillimeterPerCountQ8;
+    tEepromEncoderCalibration.LeftMillimeterPerCountQ8 = leftCarMotor.MillimeterPerCountQ8;
+    tEepromEncoderCalibration.ValidMarker = EEPROM_ENCODER_CALIBRATION_VALID_MARKER_VALUE;
+    eeprom_write_block((void*) &tEepromEncoderCalibration, (void*) EEPROM_ENCODER_CALIBRATION_ADDRESS,
+            sizeof(EepromEncoderCalibrationStruct));
+#  endif
 #endif // defined(E2END)
 }
 
+#if defined(E2END) && defined(USE_ENCODER_MOTOR_CONTROL)
+/*
+ * Reads the millimeter per count values independently of the other car values.
+ * Each value, which is missing or out of range, is set to FACTOR_COUNT_TO_MILLIMETER_Q8_DEFAULT.
+ * @return true if both values were valid
+ */
+bool CarPWMMotorControl::readEncoderCalibrationFromEeprom() {
+    EepromEncoderCalibrationStruct tEepromEncoderCalibration;
+    eeprom_read_block((void*) &tEepromEncoderCalibration, (void*) EEPROM_ENCODER_CALIBRATION_ADDRESS,
+            sizeof(EepromEncoderCalibrationStruct));
+#  if defined(DEBUG)
+    Serial.print(F("EEPROM Marker(0xC5)="));
+    Serial.print(tEepromEncoderCalibration.ValidMarker);
+    Serial.print(F(" mm/count*256 right="));
+    Serial.print(tEepromEncoderCalibration.RightMillimeterPerCountQ8);
+    Serial.print(F(" left="));
+    Serial.println(tEepromEncoderCalibration.LeftMillimeterPerCountQ8);
+#  endif
+    rightCarMotor.MillimeterPerCountQ8 = FACTOR_COUNT_TO_MILLIMETER_Q8_DEFAULT;
+    leftCarMotor.MillimeterPerCountQ8 = FACTOR_COUNT_TO_MILLIMETER_Q8_DEFAULT;
+    if (tEepromEncoderCalibration.ValidMarker != EEPROM_ENCODER_CALIBRATION_VALID_MARKER_VALUE) {
+        return false;
+    }
+    // setMillimeterPerCountQ8() ignores values out of range
+    rightCarMotor.setMillimeterPerCountQ8(tEepromEncoderCalibration.RightMillimeterPerCountQ8);
+    leftCarMotor.setMillimeterPerCountQ8(tEepromEncoderCalibration.LeftMillimeterPerCountQ8);
+    return (rightCarMotor.MillimeterPerCountQ8 == tEepromEncoderCalibration.RightMillimeterPerCountQ8
+            && leftCarMotor.MillimeterPerCountQ8 == tEepromEncoderCalibration.LeftMillimeterPerCountQ8);
+}
+#endif
+
 #if defined(LOCAL_DEBUG)
 #undef LOCAL_DEBUG
 #endif
+
+#if defined(ENABLE_ROUTE_RECORDING)
+#include "CarRouteRecorder.hpp" // Requires sTurnDirectionCharArray
+#endif
+#if defined(ENABLE_POWER_MANAGEMENT)
+#include "CarPowerManager.hpp"
+#endif
 #endif // _CAR_PWM_MOTOR_CONTROL_HPP
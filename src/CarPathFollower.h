@@ -0,0 +1,77 @@
+/*
+ * CarPathFollower.h
+ *
+ *  Pure pursuit path follower for a list of (x, y) waypoints.
+ *  The car steers on a circular arc to a lookahead point on the path, with the arc curvature computed in fixed point.
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_PATH_FOLLOWER_H
+#define _CAR_PATH_FOLLOWER_H
+
+#include "CarOdometry.h"
+
+#if !defined(PATH_FOLLOWER_LOOKAHEAD_MILLIMETER)
+#define PATH_FOLLOWER_LOOKAHEAD_MILLIMETER      250 // Bigger values give smoother, but less exact paths
+#endif
+#if !defined(PATH_FOLLOWER_GOAL_TOLERANCE_MILLIMETER)
+#define PATH_FOLLOWER_GOAL_TOLERANCE_MILLIMETER  40 // Car stops if last waypoint is nearer than this
+#endif
+#if !defined(PATH_FOLLOWER_UPDATE_INTERVAL_MILLIS)
+#define PATH_FOLLOWER_UPDATE_INTERVAL_MILLIS     50
+#endif
+
+/*
+ * Coordinates of the pose of the car at startPath(), x is forward, y is left.
+ * Waypoints must be within +/- 16 meter, to avoid overflow of squared distances.
+ */
+struct CarWaypointStruct {
+    int16_t XMillimeter;
+    int16_t YMillimeter;
+};
+
+class CarPathFollower {
+public:
+    void startPath(const CarWaypointStruct *aWaypoints, uint8_t aNumberOfWaypoints, uint8_t aSpeedPWM, bool aResetPose = true);
+    void stop();
+    bool isFollowing();
+    bool update(); // Call it in your loop after RobotCar.updateMotors(). Returns true while path is followed
+
+    /*
+     * Internal functions
+     */
+    uint8_t getLookaheadWaypointIndex();
+    void setWheelSpeedPWMForLocalTarget(int32_t aLocalXMillimeter, int32_t aLocalYMillimeter);
+
+    CarOdometry Odometry;
+    const CarWaypointStruct *Waypoints;
+    uint8_t NumberOfWaypoints;
+    uint8_t CurrentWaypointIndex;   // Index of the waypoint currently used as lookahead point
+    uint8_t SpeedPWM;               // Speed of the car center
+    bool IsFollowing;
+    uint16_t LookaheadMillimeter;
+    int32_t CurvatureQ16;           // 65536 / radius in millimeter, positive is left
+    uint16_t ObstacleMillimeter;    // If != 0, targets farther ahead than this are not driven to, the car only turns in place
+    unsigned long LastUpdateMillis;
+};
+
+extern CarPathFollower PathFollower;
+
+#endif // _CAR_PATH_FOLLOWER_H
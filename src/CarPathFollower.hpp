@@ -0,0 +1,222 @@
+/*
+ * CarPathFollower.hpp
+ *
+ *  Pure pursuit path follower for a list of (x, y) waypoints.
+ *  The pose of the car is computed by CarOdometry. Every PATH_FOLLOWER_UPDATE_INTERVAL_MILLIS the first waypoint,
+ *  which is not nearer than the lookahead distance, is taken as target. The curvature of the arc through the car center
+ *  to this target is 2 * lateral offset / distance^2, and the speeds of the left and right motors are set accordingly.
+ *  No float is used, so it runs fast on AVR.
+ *
+ *  Usage:
+ *  #include "CarPathFollower.hpp" after CarPWMMotorControl.hpp.
+ *  PathFollower.startPath(sWaypoints, 4, 120); and call PathFollower.update() in loop after RobotCar.updateMotors().
+ *
+ *  Requires CarPWMMotorControl.hpp and USE_ENCODER_MOTOR_CONTROL
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_PATH_FOLLOWER_HPP
+#define _CAR_PATH_FOLLOWER_HPP
+
+#include "CarPathFollower.h"
+#include "CarOdometry.hpp"
+
+#if defined(DEBUG)
+#define LOCAL_DEBUG
+#else
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+#endif
+
+CarPathFollower PathFollower;
+
+/*
+ * @param aWaypoints        Array must be valid until path is finished
+ * @param aSpeedPWM         Speed of the car center. The outer motor runs faster on curves, up to MAX_SPEED_PWM
+ * @param aResetPose        If true, current pose of the car is (0,0) heading along the positive x axis
+ */
+void CarPathFollower::startPath(const CarWaypointStruct *aWaypoints, uint8_t aNumberOfWaypoints, uint8_t aSpeedPWM,
+        bool aResetPose) {
+    if (aResetPose) {
+        Odometry.reset();
+    } else {
+        // only take current encoder counts as reference
+        Odometry.reset(Odometry.getXMillimeter(), Odometry.getYMillimeter(), Odometry.HeadingBinaryAngle);
+    }
+    Waypoints = aWaypoints;
+    NumberOfWaypoints = aNumberOfWaypoints;
+    CurrentWaypointIndex = 0;
+    SpeedPWM = aSpeedPWM;
+    if (LookaheadMillimeter == 0) {
+        LookaheadMillimeter = PATH_FOLLOWER_LOOKAHEAD_MILLIMETER;
+    }
+    CurvatureQ16 = 0;
+    ObstacleMillimeter = 0;
+    IsFollowing = (aNumberOfWaypoints > 0);
+    LastUpdateMillis = millis() - PATH_FOLLOWER_UPDATE_INTERVAL_MILLIS; // start at next update()
+#if defined(CAR_HAS_4_MECANUM_WHEELS)
+    RobotCar.MotorsFollowRightMotor = false; // wheels are controlled individually from now on
+#endif
+}
+
+void CarPathFollower::stop() {
+    IsFollowing = false;
+    RobotCar.stop();
+}
+
+bool CarPathFollower::isFollowing() {
+    return IsFollowing;
+}
+
+static uint32_t getSquaredDistanceToWaypoint(CarOdometry *aOdometry, const CarWaypointStruct *aWaypoint) {
+    int32_t tDeltaX = aWaypoint->XMillimeter - aOdometry->getXMillimeter();
+    int32_t tDeltaY = aWaypoint->YMillimeter - aOdometry->getYMillimeter();
+    return (uint32_t) (tDeltaX * tDeltaX) + (uint32_t) (tDeltaY * tDeltaY);
+}
+
+/*
+ * Skips all waypoints nearer than lookahead distance, except the last one
+ */
+uint8_t CarPathFollower::getLookaheadWaypointIndex() {
+    uint32_t tSquaredLookahead = (uint32_t) LookaheadMillimeter * LookaheadMillimeter;
+    while (CurrentWaypointIndex < NumberOfWaypoints - 1
+            && getSquaredDistanceToWaypoint(&Odometry, &Waypoints[CurrentWaypointIndex]) < tSquaredLookahead) {
+        CurrentWaypointIndex++;
+    }
+    return CurrentWaypointIndex;
+}
+
+/*
+ * Sets motor speeds to drive an arc to the target given in car coordinates, x is forward, y is left.
+ * Right speed = speed * (1 + curvature * half track width), left speed = speed * (1 - curvature * half track width).
+ */
+void CarPathFollower::setWheelSpeedPWMForLocalTarget(int32_t aLocalXMillimeter, int32_t aLocalYMillimeter) {
+    int32_t tLeftSpeedPWM;
+    int32_t tRightSpeedPWM;
+    if (aLocalXMillimeter <= 0) {
+        /*
+         * Target is beside or behind us, turn in place towards target
+         */
+        CurvatureQ16 = 0;
+        if (aLocalYMillimeter >= 0) {
+            tLeftSpeedPWM = -(int) SpeedPWM;
+            tRightSpeedPWM = SpeedPWM;
+        } else {
+            tLeftSpeedPWM = SpeedPWM;
+            tRightSpeedPWM = -(int) SpeedPWM;
+        }
+    } else {
+        /*
+         * Divisor is scaled by 1/256 to avoid overflow of the dividend
+         */
+        uint32_t tSquaredDistanceShift8 = ((uint32_t) (aLocalXMillimeter * aLocalXMillimeter)
+                + (uint32_t) (aLocalYMillimeter * aLocalYMillimeter)) >> 8;
+        if (tSquaredDistanceShift8 == 0) {
+            tSquaredDistanceShift8 = 1;
+        }
+        CurvatureQ16 = (aLocalYMillimeter << 9) / (int32_t) tSquaredDistanceShift8; // (2 * y << 16) / distance^2
+
+        uint16_t tMillimeterPer256DegreeInPlace = RobotCar.MillimeterPer256DegreeInPlace;
+        if (tMillimeterPer256DegreeInPlace == 0) {
+            tMillimeterPer256DegreeInPlace = DEFAULT_MILLIMETER_PER_256_DEGREE_IN_PLACE;
+        }
+        // half track width is MillimeterPer256DegreeInPlace * 180 / (256 * PI) = MillimeterPer256DegreeInPlace * 57 / 256
+        int32_t tHalfTrackMillimeter = ((uint32_t) tMillimeterPer256DegreeInPlace * 57) >> 8;
+        int32_t tDifferenceQ16 = CurvatureQ16 * tHalfTrackMillimeter;
+        // Limit to turning in place
+        if (tDifferenceQ16 > 0x20000L) {
+            tDifferenceQ16 = 0x20000L;
+        } else if (tDifferenceQ16 < -0x20000L) {
+            tDifferenceQ16 = -0x20000L;
+        }
+        tRightSpeedPWM = ((int32_t) SpeedPWM * (0x10000L + tDifferenceQ16)) >> 16;
+        tLeftSpeedPWM = ((int32_t) SpeedPWM * (0x10000L - tDifferenceQ16)) >> 16;
+
+        /*
+         * Keep the speed ratio if outer motor exceeds MAX_SPEED_PWM
+         */
+        int32_t tMaxSpeedPWM = max(abs(tRightSpeedPWM), abs(tLeftSpeedPWM));
+        if (tMaxSpeedPWM > MAX_SPEED_PWM) {
+            tRightSpeedPWM = (tRightSpeedPWM * MAX_SPEED_PWM) / tMaxSpeedPWM;
+            tLeftSpeedPWM = (tLeftSpeedPWM * MAX_SPEED_PWM) / tMaxSpeedPWM;
+        }
+    }
+#if defined(LOCAL_DEBUG)
+    Serial.print(F("Target x="));
+    Serial.print(aLocalXMillimeter);
+    Serial.print(F(" y="));
+    Serial.print(aLocalYMillimeter);
+    Serial.print(F(" curvature*65536="));
+    Serial.print(CurvatureQ16);
+    Serial.print(F(" PWM left="));
+    Serial.print(tLeftSpeedPWM);
+    Serial.print(F(" right="));
+    Serial.println(tRightSpeedPWM);
+#endif
+    RobotCar.setSpeedPWM((int) tLeftSpeedPWM, (int) tRightSpeedPWM); // for mecanum car, this disables following of the right motor
+}
+
+/*
+ * Updates pose and motor speeds every PATH_FOLLOWER_UPDATE_INTERVAL_MILLIS
+ * @return true while path is followed, false if last waypoint is reached or path was stopped
+ */
+bool CarPathFollower::update() {
+    if (!IsFollowing) {
+        return false;
+    }
+    if (millis() - LastUpdateMillis < PATH_FOLLOWER_UPDATE_INTERVAL_MILLIS) {
+        return true;
+    }
+    LastUpdateMillis = millis();
+    Odometry.update();
+
+    uint8_t tIndex = getLookaheadWaypointIndex();
+    const CarWaypointStruct *tTarget = &Waypoints[tIndex];
+    if (tIndex == NumberOfWaypoints - 1
+            && getSquaredDistanceToWaypoint(&Odometry, tTarget)
+                    < (uint32_t) PATH_FOLLOWER_GOAL_TOLERANCE_MILLIMETER * PATH_FOLLOWER_GOAL_TOLERANCE_MILLIMETER) {
+#if defined(LOCAL_DEBUG)
+        Serial.print(F("Path end reached. "));
+        Odometry.printPose(&Serial);
+#endif
+        stop();
+        return false;
+    }
+
+    /*
+     * Rotate target into car coordinates
+     */
+    int32_t tDeltaX = tTarget->XMillimeter - Odometry.getXMillimeter();
+    int32_t tDeltaY = tTarget->YMillimeter - Odometry.getYMillimeter();
+    int32_t tCosine = getCosineQ14(Odometry.HeadingBinaryAngle);
+    int32_t tSine = getSineQ14(Odometry.HeadingBinaryAngle);
+    int32_t tLocalX = (tDeltaX * tCosine + tDeltaY * tSine) >> 14;
+    int32_t tLocalY = (tDeltaY * tCosine - tDeltaX * tSine) >> 14;
+    if (ObstacleMillimeter != 0 && tLocalX > (int32_t) ObstacleMillimeter) {
+        tLocalX = 0; // Do not drive into the obstacle, turn towards the target instead
+    }
+
+    setWheelSpeedPWMForLocalTarget(tLocalX, tLocalY);
+    return true;
+}
+
+#if defined(LOCAL_DEBUG)
+#undef LOCAL_DEBUG
+#endif
+#endif // _CAR_PATH_FOLLOWER_HPP
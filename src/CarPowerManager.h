@@ -0,0 +1,64 @@
+/*
+ * CarPowerManager.h
+ *
+ *  Limits the motor PWM to keep VIN above a threshold, to avoid brown out resets of the CPU on weak batteries.
+ *  The voltage drop per PWM unit, which reflects the battery internal resistance, is estimated online from VIN samples.
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_POWER_MANAGER_H
+#define _CAR_POWER_MANAGER_H
+
+#include "CarPWMMotorControl.h"
+
+#if !defined(POWER_MANAGER_MIN_VIN_MILLIVOLT)
+#define POWER_MANAGER_MIN_VIN_MILLIVOLT     ((FULL_BRIDGE_INPUT_MILLIVOLT * 3) / 4) // 4500 for 4 x AA, 5550 for 2 Li-ion
+#endif
+#if !defined(POWER_MANAGER_DEFAULT_SAG_MILLIVOLT)
+#define POWER_MANAGER_DEFAULT_SAG_MILLIVOLT 1000 // Guessed VIN drop if both motors run at MAX_SPEED_PWM. Used until first estimation.
+#endif
+#define POWER_MANAGER_MIN_PWM_STEP            32 // Minimum change of the sum of both PWM values between 2 samples for estimation of the sag
+#define POWER_MANAGER_MAX_SAMPLE_DISTANCE_MILLIS 3000 // Older samples are not used for estimation, since battery voltage may have changed
+
+class CarPowerManager {
+public:
+    CarPowerManager();
+    void update(uint16_t aVINMillivolt); // Call it after each VIN measurement
+    uint16_t getPredictedVINMillivolt(uint8_t aSpeedPWM);
+    void setMinVINMillivolt(uint16_t aMinVINMillivolt);
+    void printValues(Print *aSerial);
+
+    /*
+     * Internal functions
+     */
+    uint16_t getSpeedPWMSum();
+    void setSpeedPWMLimit();
+
+    uint16_t MinVINMillivolt;
+    uint16_t OpenCircuitMillivolt;          // Estimated VIN without motor load
+    uint16_t SagMillivoltPerSpeedPWMQ8;     // Estimated VIN drop for 1 PWM unit of the sum of both motors * 256
+    uint16_t LastVINMillivolt;
+    uint16_t LastSpeedPWMSum;               // Sum of CurrentCompensatedSpeedPWM of both motors at last VIN sample
+    unsigned long LastSampleMillis;
+};
+
+extern CarPowerManager PowerManager;
+
+#endif // _CAR_POWER_MANAGER_H
@@ -0,0 +1,139 @@
+/*
+ * CarPowerManager.hpp
+ *
+ *  Limits the motor PWM to keep VIN above MinVINMillivolt, to avoid brown out resets of the CPU on weak batteries.
+ *
+ *  VIN drops proportional to the motor current, which is roughly proportional to the PWM.
+ *  The drop per PWM unit is estimated from 2 consecutive VIN samples taken at different PWM values,
+ *  and is then used to predict the VIN for a requested PWM and to compute the PWM limit.
+ *  No ADC reads are done here, just call PowerManager.update() after each of your regular VIN measurements.
+ *  The limit is applied in PWMDcMotor::setSpeedPWM() and therefore also for ramps.
+ *
+ *  Requires CarPWMMotorControl.hpp
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_POWER_MANAGER_HPP
+#define _CAR_POWER_MANAGER_HPP
+
+#include "CarPowerManager.h"
+
+#if defined(DEBUG)
+#define LOCAL_DEBUG
+#else
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+#endif
+
+CarPowerManager PowerManager;
+
+CarPowerManager::CarPowerManager() { // @suppress("Class members should be properly initialized")
+    MinVINMillivolt = POWER_MANAGER_MIN_VIN_MILLIVOLT;
+    SagMillivoltPerSpeedPWMQ8 = ((uint32_t) POWER_MANAGER_DEFAULT_SAG_MILLIVOLT << 8) / (2 * MAX_SPEED_PWM);
+}
+
+void CarPowerManager::setMinVINMillivolt(uint16_t aMinVINMillivolt) {
+    MinVINMillivolt = aMinVINMillivolt;
+    setSpeedPWMLimit();
+}
+
+uint16_t CarPowerManager::getSpeedPWMSum() {
+    return RobotCar.rightCarMotor.CurrentCompensatedSpeedPWM + RobotCar.leftCarMotor.CurrentCompensatedSpeedPWM;
+}
+
+/*
+ * Updates the sag estimation and the PWM limit.
+ * Sag is only estimated if PWM changed enough since last sample and last sample is not too old.
+ * @param aVINMillivolt Voltage just measured
+ */
+void CarPowerManager::update(uint16_t aVINMillivolt) {
+    uint16_t tSpeedPWMSum = getSpeedPWMSum();
+    unsigned long tMillis = millis();
+
+    if (LastSampleMillis != 0 && tMillis - LastSampleMillis < POWER_MANAGER_MAX_SAMPLE_DISTANCE_MILLIS) {
+        int tDeltaSpeedPWM = tSpeedPWMSum - LastSpeedPWMSum;
+        if (abs(tDeltaSpeedPWM) >= POWER_MANAGER_MIN_PWM_STEP) {
+            // Positive if voltage dropped for more PWM
+            int32_t tSagMillivoltPerSpeedPWMQ8 = ((int32_t) ((int) LastVINMillivolt - (int) aVINMillivolt) << 8) / tDeltaSpeedPWM;
+            if (tSagMillivoltPerSpeedPWMQ8 > 0) {
+                // Low pass of 1/4
+                SagMillivoltPerSpeedPWMQ8 = (((uint32_t) SagMillivoltPerSpeedPWMQ8 * 3) + tSagMillivoltPerSpeedPWMQ8) / 4;
+            }
+        }
+    }
+    LastVINMillivolt = aVINMillivolt;
+    LastSpeedPWMSum = tSpeedPWMSum;
+    LastSampleMillis = tMillis;
+    OpenCircuitMillivolt = aVINMillivolt + (((uint32_t) SagMillivoltPerSpeedPWMQ8 * tSpeedPWMSum) >> 8);
+
+    setSpeedPWMLimit();
+}
+
+/*
+ * @return Predicted VIN if both motors run at aSpeedPWM
+ */
+uint16_t CarPowerManager::getPredictedVINMillivolt(uint8_t aSpeedPWM) {
+    uint16_t tSagMillivolt = ((uint32_t) SagMillivoltPerSpeedPWMQ8 * (2 * aSpeedPWM)) >> 8;
+    if (tSagMillivolt >= OpenCircuitMillivolt) {
+        return 0;
+    }
+    return OpenCircuitMillivolt - tSagMillivolt;
+}
+
+/*
+ * Sets PWMDcMotor::SpeedPWMLimit to the max PWM of both motors which keeps VIN above MinVINMillivolt,
+ * but not below DEFAULT_START_SPEED_PWM, to be able to continue driving slowly.
+ * Running motors get the new limit immediately.
+ */
+void CarPowerManager::setSpeedPWMLimit() {
+    uint16_t tSpeedPWMLimit = DEFAULT_START_SPEED_PWM;
+    if (OpenCircuitMillivolt > MinVINMillivolt && SagMillivoltPerSpeedPWMQ8 > 0) {
+        uint32_t tSpeedPWMSumLimit = ((uint32_t) (OpenCircuitMillivolt - MinVINMillivolt) << 8) / SagMillivoltPerSpeedPWMQ8;
+        if (tSpeedPWMSumLimit >= 2 * MAX_SPEED_PWM) {
+            tSpeedPWMLimit = MAX_SPEED_PWM;
+        } else if (tSpeedPWMSumLimit / 2 > DEFAULT_START_SPEED_PWM) {
+            tSpeedPWMLimit = tSpeedPWMSumLimit / 2;
+        }
+    }
+    if (PWMDcMotor::SpeedPWMLimit != tSpeedPWMLimit) {
+        PWMDcMotor::SpeedPWMLimit = tSpeedPWMLimit;
+#if defined(LOCAL_DEBUG)
+        printValues(&Serial);
+#endif
+        // Apply new limit to running motors and to their ramp and blend targets
+        RobotCar.rightCarMotor.applySpeedPWMLimit();
+        RobotCar.leftCarMotor.applySpeedPWMLimit();
+    }
+}
+
+void CarPowerManager::printValues(Print *aSerial) {
+    aSerial->print(F("VIN="));
+    aSerial->print(LastVINMillivolt);
+    aSerial->print(F(" mV open circuit="));
+    aSerial->print(OpenCircuitMillivolt);
+    aSerial->print(F(" mV sag at max PWM="));
+    aSerial->print(((uint32_t) SagMillivoltPerSpeedPWMQ8 * (2 * MAX_SPEED_PWM)) >> 8);
+    aSerial->print(F(" mV PWM limit="));
+    aSerial->println(PWMDcMotor::SpeedPWMLimit);
+}
+
+#if defined(LOCAL_DEBUG)
+#undef LOCAL_DEBUG
+#endif
+#endif // _CAR_POWER_MANAGER_HPP
@@ -0,0 +1,121 @@
+/*
+ * CarRouteRecorder.h
+ *
+ *  Records the motion primitives executed by CarPWMMotorControl (go distance, rotate) and replays them non blocking.
+ *  Teach a route once e.g. by IR or BlueDisplay control, store it in EEPROM and repeat it as often as you want.
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_ROUTE_RECORDER_H
+#define _CAR_ROUTE_RECORDER_H
+
+#include "CarPWMMotorControl.h"
+
+#if !defined(ROUTE_MAX_NUMBER_OF_STEPS)
+#define ROUTE_MAX_NUMBER_OF_STEPS           24 // 4 bytes RAM per step, 6 bytes if USE_MPU6050_IMU is defined
+#endif
+#if !defined(ROUTE_DELAY_BETWEEN_STEPS_MILLIS)
+#define ROUTE_DELAY_BETWEEN_STEPS_MILLIS   200 // Let car and IMU settle before starting the next step of replay
+#endif
+#if !defined(ROUTE_MIN_HEADING_CORRECTION_DEGREE)
+#define ROUTE_MIN_HEADING_CORRECTION_DEGREE  3 // Heading errors below this value are not corrected by an extra rotation before going straight
+#endif
+#if !defined(ROUTE_EEPROM_ADDRESS)
+#define ROUTE_EEPROM_ADDRESS                sizeof(EepromCarInfoStruct) // Directly behind the car calibration values
+#endif
+#define EEPROM_ROUTE_VALID_MARKER_VALUE     0x5A
+
+/*
+ * Step types. The rotation types are the values of turn_direction_t.
+ */
+#define ROUTE_STEP_TURN_IN_PLACE    TURN_IN_PLACE   // 0
+#define ROUTE_STEP_TURN_FORWARD     TURN_FORWARD    // 1
+#define ROUTE_STEP_TURN_BACKWARD    TURN_BACKWARD   // 2
+#define ROUTE_STEP_GO               3
+
+struct CarRouteStepStruct {
+    int16_t Value;      // Signed distance in millimeter for ROUTE_STEP_GO, signed degree for rotations. Positive -> forward / turn left
+    uint8_t SpeedPWM;   // SpeedPWM for ROUTE_STEP_GO, aUseSlowSpeed flag for rotations
+    uint8_t Type;       // ROUTE_STEP_GO, ROUTE_STEP_TURN_IN_PLACE, ROUTE_STEP_TURN_FORWARD, ROUTE_STEP_TURN_BACKWARD
+#if defined(USE_MPU6050_IMU)
+    int16_t HeadingHalfDegree; // Accumulated heading of the car after this step, measured by IMU. 0 is the heading at start of recording
+#endif
+};
+
+struct EepromRouteHeaderStruct {
+    uint8_t NumberOfSteps;
+    uint8_t ValidMarker; // must be 0x5A
+};
+
+#define ROUTE_STATE_IDLE        0
+#define ROUTE_STATE_RECORDING   1
+#define ROUTE_STATE_REPLAYING   2
+
+class CarRouteRecorder {
+public:
+    CarRouteRecorder();
+
+    /*
+     * Recording
+     */
+    void startRecording();
+    void stopRecording();
+    void recordStep(uint8_t aStepType, int aValue, uint8_t aSpeedPWM); // Called by CarPWMMotorControl start functions
+    void clear();
+
+    /*
+     * Replay
+     */
+    void startReplay(bool aRepeatForever = false);
+    void stopReplay();
+    bool isReplaying();
+
+    bool update(); // Call it in your loop after RobotCar.updateMotors()
+
+    bool readRouteFromEeprom();
+    void writeRouteToEeprom();
+    void printRoute(Print *aSerial);
+
+    /*
+     * Internal functions
+     */
+    void finishPendingStep();
+    void startNextReplayStep();
+    int getMeasuredStepValue();
+
+    CarRouteStepStruct Steps[ROUTE_MAX_NUMBER_OF_STEPS];
+    uint8_t NumberOfSteps;
+    uint8_t State;              // ROUTE_STATE_IDLE, ROUTE_STATE_RECORDING or ROUTE_STATE_REPLAYING
+    uint8_t CurrentStepIndex;   // Index of step currently recorded or replayed
+    bool StepIsPending;         // A step was started, but is not yet finished
+    uint8_t PendingStepType;
+    int PendingStepValue;       // The value requested for the pending step
+    bool CarHasStopped;         // Car has stopped after pending step and we wait for NextStepMillis
+    bool RepeatReplay;
+    unsigned long NextStepMillis;
+    int DistanceErrorMillimeter; // Requested - measured distance of last go step. It is added to the next go step of replay
+#if defined(USE_MPU6050_IMU)
+    int HeadingHalfDegree;      // Current heading accumulated from IMU turn angles of all steps
+#endif
+};
+
+extern CarRouteRecorder RouteRecorder;
+
+#endif // _CAR_ROUTE_RECORDER_H
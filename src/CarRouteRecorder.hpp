@@ -0,0 +1,367 @@
+/*
+ * CarRouteRecorder.hpp
+ *
+ *  Records the motion primitives executed by CarPWMMotorControl (go distance, rotate) and replays them non blocking.
+ *  At the end of each recorded step the measured values (encoder distance / IMU turn angle) are stored instead of the requested ones.
+ *  At replay, the measured error of each step is corrected at the next step.
+ *
+ *  Usage:
+ *  RouteRecorder.startRecording(); drive the car by IR or GUI commands; RouteRecorder.stopRecording(); RouteRecorder.writeRouteToEeprom();
+ *  RouteRecorder.startReplay(true); and call RouteRecorder.update() in loop after RobotCar.updateMotors().
+ *
+ *  Requires CarPWMMotorControl.hpp
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of PWMMotorControl https://github.com/ArminJo/PWMMotorControl.
+ *
+ *  PWMMotorControl is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ */
+
+#ifndef _CAR_ROUTE_RECORDER_HPP
+#define _CAR_ROUTE_RECORDER_HPP
+
+#include "CarRouteRecorder.h"
+
+#if defined(DEBUG)
+#define LOCAL_DEBUG
+#else
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+#endif
+
+CarRouteRecorder RouteRecorder;
+
+CarRouteRecorder::CarRouteRecorder() { // @suppress("Class members should be properly initialized")
+}
+
+void CarRouteRecorder::clear() {
+    NumberOfSteps = 0;
+    CurrentStepIndex = 0;
+    StepIsPending = false;
+    DistanceErrorMillimeter = 0;
+#if defined(USE_MPU6050_IMU)
+    HeadingHalfDegree = 0;
+#endif
+}
+
+/*
+ * Clears current route and starts recording of all following startGoDistanceMillimeter*() and startRotate() calls
+ */
+void CarRouteRecorder::startRecording() {
+    clear();
+    State = ROUTE_STATE_RECORDING;
+}
+
+void CarRouteRecorder::stopRecording() {
+    if (State == ROUTE_STATE_RECORDING) {
+        finishPendingStep();
+        State = ROUTE_STATE_IDLE;
+    }
+}
+
+/*
+ * Called by CarPWMMotorControl::startGoDistanceMillimeterWithSpeed() and CarPWMMotorControl::startRotate()
+ * before any car values are changed. It finishes a still pending step with its current measured values.
+ * @param aStepType ROUTE_STEP_GO or turn_direction_t value of rotation
+ * @param aValue Signed distance in millimeter or signed rotation degrees
+ * @param aSpeedPWM Speed for going a distance, or aUseSlowSpeed flag for rotations
+ */
+void CarRouteRecorder::recordStep(uint8_t aStepType, int aValue, uint8_t aSpeedPWM) {
+    if (State != ROUTE_STATE_RECORDING) {
+        return;
+    }
+    finishPendingStep();
+    if (aValue == 0 || NumberOfSteps >= ROUTE_MAX_NUMBER_OF_STEPS) {
+#if defined(LOCAL_DEBUG)
+        if (aValue != 0) {
+            Serial.println(F("Route buffer full"));
+        }
+#endif
+        return;
+    }
+    CurrentStepIndex = NumberOfSteps;
+    CarRouteStepStruct *tStep = &Steps[NumberOfSteps++];
+    tStep->Value = aValue;
+    tStep->SpeedPWM = aSpeedPWM;
+    tStep->Type = aStepType;
+    PendingStepType = aStepType;
+    PendingStepValue = aValue;
+    StepIsPending = true;
+    CarHasStopped = false;
+}
+
+/*
+ * @return The signed distance or rotation degrees the car has driven since start of the pending step.
+ *         The requested value, if we have no sensor for it.
+ */
+int CarRouteRecorder::getMeasuredStepValue() {
+    int tRequestedValue = PendingStepValue;
+    uint32_t tMeasuredValue = abs(tRequestedValue);
+
+    if (PendingStepType == ROUTE_STEP_GO) {
+#if defined(USE_ENCODER_MOTOR_CONTROL)
+        tMeasuredValue = ((uint32_t) RobotCar.rightCarMotor.getDistanceMillimeter() + RobotCar.leftCarMotor.getDistanceMillimeter())
+                / 2;
+#elif defined(USE_MPU6050_IMU)
+        tMeasuredValue = RobotCar.CarDistanceMillimeterFromIMU;
+#endif
+    } else {
+#if defined(USE_MPU6050_IMU)
+        return RobotCar.CarTurnAngleHalfDegreesFromIMU / 2; // IMU value is already signed, positive is left
+#elif defined(USE_ENCODER_MOTOR_CONTROL)
+        // Take the motor which has driven the larger distance, for TURN_FORWARD and TURN_BACKWARD only one motor is running
+        tMeasuredValue = max(RobotCar.rightCarMotor.getDistanceMillimeter(), RobotCar.leftCarMotor.getDistanceMillimeter());
+        uint16_t tMillimeterPer256Degree = RobotCar.MillimeterPer256Degree;
+        if (PendingStepType == ROUTE_STEP_TURN_IN_PLACE) {
+            tMillimeterPer256Degree = RobotCar.MillimeterPer256DegreeInPlace;
+        }
+        tMeasuredValue = (tMeasuredValue * 256) / tMillimeterPer256Degree;
+#endif
+    }
+    if (tRequestedValue < 0) {
+        return -(int) tMeasuredValue;
+    }
+    return tMeasuredValue;
+}
+
+/*
+ * Stores measured values of step for recording or computes the errors to be corrected at next step for replay
+ */
+void CarRouteRecorder::finishPendingStep() {
+    if (!StepIsPending) {
+        return;
+    }
+    StepIsPending = false;
+    int tMeasuredValue = getMeasuredStepValue();
+#if defined(USE_MPU6050_IMU)
+    // The IMU turn angle is reset at each start of a step, so accumulate it here. This includes the drift of a go step.
+    HeadingHalfDegree += RobotCar.CarTurnAngleHalfDegreesFromIMU;
+#endif
+
+    if (State == ROUTE_STATE_RECORDING) {
+        Steps[CurrentStepIndex].Value = tMeasuredValue;
+#if defined(USE_MPU6050_IMU)
+        Steps[CurrentStepIndex].HeadingHalfDegree = HeadingHalfDegree;
+#endif
+    } else if (PendingStepType == ROUTE_STEP_GO) {
+        // positive error -> we have driven too short
+        DistanceErrorMillimeter = abs(PendingStepValue) - abs(tMeasuredValue);
+    }
+
+#if defined(LOCAL_DEBUG)
+    Serial.print(F("Step "));
+    Serial.print(CurrentStepIndex);
+    Serial.print(F(" requested="));
+    Serial.print(PendingStepValue);
+    Serial.print(F(" measured="));
+    Serial.print(tMeasuredValue);
+#  if defined(USE_MPU6050_IMU)
+    Serial.print(F(" heading="));
+    Serial.print(HeadingHalfDegree / 2);
+#  endif
+    Serial.println();
+#endif
+}
+
+/*
+ * @param aRepeatForever If true, replay starts again with the first step after the last one. Useful for delivery loops.
+ */
+void CarRouteRecorder::startReplay(bool aRepeatForever) {
+    stopRecording();
+    if (NumberOfSteps == 0) {
+        return;
+    }
+    CurrentStepIndex = 0;
+    StepIsPending = false;
+    DistanceErrorMillimeter = 0;
+#if defined(USE_MPU6050_IMU)
+    HeadingHalfDegree = 0;
+#endif
+    RepeatReplay = aRepeatForever;
+    State = ROUTE_STATE_REPLAYING;
+}
+
+void CarRouteRecorder::stopReplay() {
+    if (State == ROUTE_STATE_REPLAYING) {
+        State = ROUTE_STATE_IDLE;
+        StepIsPending = false;
+        RobotCar.stop();
+    }
+}
+
+bool CarRouteRecorder::isReplaying() {
+    return (State == ROUTE_STATE_REPLAYING);
+}
+
+/*
+ * Starts the next step of the route with the corrections for the errors of the previous steps.
+ * With IMU, a heading error before a go step is corrected by an extra slow rotation in place, which does not advance the step index.
+ */
+void CarRouteRecorder::startNextReplayStep() {
+    if (CurrentStepIndex >= NumberOfSteps) {
+        if (!RepeatReplay) {
+            State = ROUTE_STATE_IDLE;
+            return;
+        }
+        CurrentStepIndex = 0;
+#if defined(USE_MPU6050_IMU)
+        // Heading at end of route is the heading at start of the next round
+        HeadingHalfDegree -= Steps[NumberOfSteps - 1].HeadingHalfDegree;
+#endif
+    }
+    CarRouteStepStruct *tStep = &Steps[CurrentStepIndex];
+    int tValue = tStep->Value;
+
+#if defined(USE_MPU6050_IMU)
+    int tHeadingErrorHalfDegree = -HeadingHalfDegree;
+    if (CurrentStepIndex > 0) {
+        tHeadingErrorHalfDegree += Steps[CurrentStepIndex - 1].HeadingHalfDegree;
+    }
+    // Take the shortest way
+    tHeadingErrorHalfDegree %= 720;
+    if (tHeadingErrorHalfDegree > 360) {
+        tHeadingErrorHalfDegree -= 720;
+    } else if (tHeadingErrorHalfDegree < -360) {
+        tHeadingErrorHalfDegree += 720;
+    }
+    if (tStep->Type == ROUTE_STEP_GO) {
+        if (abs(tHeadingErrorHalfDegree) >= ROUTE_MIN_HEADING_CORRECTION_DEGREE * 2) {
+            PendingStepType = ROUTE_STEP_TURN_IN_PLACE;
+            PendingStepValue = tHeadingErrorHalfDegree / 2;
+            RobotCar.startRotate(PendingStepValue, TURN_IN_PLACE, true);
+            StepIsPending = true;
+            CarHasStopped = false;
+            return;
+        }
+    } else {
+        tValue += tHeadingErrorHalfDegree / 2;
+    }
+#endif
+
+    if (tStep->Type == ROUTE_STEP_GO) {
+        if (tValue < 0) {
+            tValue -= DistanceErrorMillimeter;
+        } else {
+            tValue += DistanceErrorMillimeter;
+        }
+        DistanceErrorMillimeter = 0;
+        RobotCar.startGoDistanceMillimeterWithSpeed(tStep->SpeedPWM, tValue);
+    } else {
+        RobotCar.startRotate(tValue, (turn_direction_t) tStep->Type, tStep->SpeedPWM);
+    }
+    PendingStepType = tStep->Type;
+    PendingStepValue = tValue;
+    StepIsPending = true;
+    CarHasStopped = false;
+    CurrentStepIndex++;
+}
+
+/*
+ * A step is finished if the car has stopped and ROUTE_DELAY_BETWEEN_STEPS_MILLIS are over to include the overrun in the measured values.
+ * @return true if recording or replay is active
+ */
+bool CarRouteRecorder::update() {
+    if (State == ROUTE_STATE_IDLE) {
+        return false;
+    }
+    if (StepIsPending) {
+        bool tCarIsStopped = RobotCar.isStopped();
+#if !defined(DO_NOT_SUPPORT_RAMP)
+        // Motor is not started until next updateMotor()
+        if (RobotCar.rightCarMotor.MotorRampState == MOTOR_STATE_START || RobotCar.leftCarMotor.MotorRampState == MOTOR_STATE_START) {
+            tCarIsStopped = false;
+        }
+#endif
+        if (!tCarIsStopped) {
+            CarHasStopped = false;
+            return true;
+        }
+        if (!CarHasStopped) {
+            CarHasStopped = true;
+            NextStepMillis = millis() + ROUTE_DELAY_BETWEEN_STEPS_MILLIS;
+        }
+        if ((long) (millis() - NextStepMillis) < 0) {
+            return true;
+        }
+        finishPendingStep();
+    }
+    if (State == ROUTE_STATE_REPLAYING) {
+        startNextReplayStep();
+    }
+    return (State != ROUTE_STATE_IDLE);
+}
+
+/********************************************************************************************
+ * EEPROM functions
+ * The route is stored directly behind the EepromCarInfoStruct
+ ********************************************************************************************/
+/*
+ * @return true if reading was successful
+ */
+bool CarRouteRecorder::readRouteFromEeprom() {
+#if defined(E2END)
+    EepromRouteHeaderStruct tEepromRouteHeader;
+    eeprom_read_block((void*) &tEepromRouteHeader, (void*) ROUTE_EEPROM_ADDRESS, sizeof(EepromRouteHeaderStruct));
+    if (tEepromRouteHeader.ValidMarker == EEPROM_ROUTE_VALID_MARKER_VALUE
+            && tEepromRouteHeader.NumberOfSteps <= ROUTE_MAX_NUMBER_OF_STEPS) {
+        clear();
+        NumberOfSteps = tEepromRouteHeader.NumberOfSteps;
+        eeprom_read_block((void*) Steps, (void*) (ROUTE_EEPROM_ADDRESS + sizeof(EepromRouteHeaderStruct)),
+                NumberOfSteps * sizeof(CarRouteStepStruct));
+        return true;
+    }
+#endif
+    return false;
+}
+
+void CarRouteRecorder::writeRouteToEeprom() {
+#if defined(E2END)
+    EepromRouteHeaderStruct tEepromRouteHeader;
+    tEepromRouteHeader.NumberOfSteps = NumberOfSteps;
+    tEepromRouteHeader.ValidMarker = EEPROM_ROUTE_VALID_MARKER_VALUE;
+    eeprom_write_block((void*) &tEepromRouteHeader, (void*) ROUTE_EEPROM_ADDRESS, sizeof(EepromRouteHeaderStruct));
+    eeprom_write_block((void*) Steps, (void*) (ROUTE_EEPROM_ADDRESS + sizeof(EepromRouteHeaderStruct)),
+            NumberOfSteps * sizeof(CarRouteStepStruct));
+#endif
+}
+
+void CarRouteRecorder::printRoute(Print *aSerial) {
+    aSerial->print(NumberOfSteps);
+    aSerial->println(F(" route steps:"));
+    for (uint_fast8_t i = 0; i < NumberOfSteps; ++i) {
+        aSerial->print(i);
+        if (Steps[i].Type == ROUTE_STEP_GO) {
+            aSerial->print(F(" go "));
+            aSerial->print(Steps[i].Value);
+            aSerial->print(F(" mm with PWM="));
+            aSerial->print(Steps[i].SpeedPWM);
+        } else {
+            aSerial->print(F(" rotate "));
+            aSerial->print(Steps[i].Value);
+            aSerial->print(F(" deg "));
+            aSerial->print(sTurnDirectionCharArray[Steps[i].Type]);
+        }
+#if defined(USE_MPU6050_IMU)
+        aSerial->print(F(" heading="));
+        aSerial->print(Steps[i].HeadingHalfDegree / 2);
+#endif
+        aSerial->println();
+    }
+}
+
+#if defined(LOCAL_DEBUG)
+#undef LOCAL_DEBUG
+#endif
+#endif // _CAR_ROUTE_RECORDER_HPP
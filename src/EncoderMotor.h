@@ -35,6 +35,21 @@
 
 // Maybe useful especially for more than 2 motors
 //#define ENABLE_MOTOR_LIST_FUNCTIONS     // Enables the convenience functions *AllMotors*() and *forAll(). Requires up to 80 bytes program space and 7 bytes RAM.
+//#define ENABLE_TIMER_SCHEDULED_STOP     // Brake at target distance by timer0 compare A interrupt, independent of the calls of updateMotor(). AVR only.
+
+#if defined(ENABLE_TIMER_SCHEDULED_STOP)
+#  if !defined(OCIE0A)
+#error ENABLE_TIMER_SCHEDULED_STOP requires the timer0 compare A interrupt of AVR
+#  elif defined(USE_ADAFRUIT_MOTOR_SHIELD)
+#error ENABLE_TIMER_SCHEDULED_STOP is not supported for Adafruit Motor Shield, since I2C can not be used in an ISR
+#  elif defined(ENABLE_DECAY_MODE_SELECTION) || defined(ENABLE_BACKLASH_COMPENSATION)
+// The ISR calls writeSpeedPWM() and setMotorDriverMode(), which must then be reduced to a few port writes
+#error ENABLE_TIMER_SCHEDULED_STOP is not supported together with ENABLE_DECAY_MODE_SELECTION, USE_DRV8833_BRIDGE or ENABLE_BACKLASH_COMPENSATION
+#  endif
+#define SCHEDULED_STOP_NONE     0
+#define SCHEDULED_STOP_ARMED    1 // Target is reached before next encoder interrupt, timer0 compare A interrupt is enabled
+#define SCHEDULED_STOP_BRAKED   2 // Motor was braked by ISR, stop() is called by next updateMotor()
+#endif
 
 /*
  * 20 slot Encoder generates 4 to 5 Hz at min speed and 110 Hz at max speed => 200 to 8 ms per period
@@ -51,6 +66,12 @@
 // Exact value is 220 mm / 20 = 11 mm
 #define FACTOR_COUNT_TO_MILLIMETER_INTEGER_DEFAULT  ((DEFAULT_CIRCUMFERENCE_MILLIMETER + (ENCODER_COUNTS_PER_FULL_ROTATION / 2)) / ENCODER_COUNTS_PER_FULL_ROTATION) // = 11
 #endif
+/*
+ * Millimeter per count * 256. Used as initial value of MillimeterPerCountQ8, which can be calibrated and stored in EEPROM.
+ */
+#define FACTOR_COUNT_TO_MILLIMETER_Q8_DEFAULT   (((DEFAULT_CIRCUMFERENCE_MILLIMETER * 256L) + (ENCODER_COUNTS_PER_FULL_ROTATION / 2)) / ENCODER_COUNTS_PER_FULL_ROTATION) // = 2816
+#define MILLIMETER_PER_COUNT_Q8_MIN             (FACTOR_COUNT_TO_MILLIMETER_Q8_DEFAULT / 2) // Plausibility limits for EEPROM and calibration values
+#define MILLIMETER_PER_COUNT_Q8_MAX             (FACTOR_COUNT_TO_MILLIMETER_Q8_DEFAULT * 2)
 
 /*
  * The millis per tick have the unit [ms]/ (circumference[cm]/countsPerCircumference) -> ms/cm
@@ -95,13 +116,21 @@ public:
     void IRAM_ATTR handleEncoderInterrupt();
 #else
     void handleEncoderInterrupt();
+#endif
+#if defined(ENABLE_TIMER_SCHEDULED_STOP)
+    void scheduleStop(unsigned long aEncoderInterruptMillis);
+    bool checkScheduledStop();
 #endif
     void attachEncoderInterrupt(uint8_t aEncoderInterruptPinNumber);
     static void enableINT0AndINT1InterruptsOnRisingEdge();
 
     uint8_t getDirection();
     unsigned int getDistanceMillimeter();
+    unsigned int getInterpolatedDistanceMillimeter(); // Distance with fraction of the current encoder period. Used for stop decisions.
     unsigned int getDistanceCentimeter();
+    unsigned int getFreeRunningEncoderCount();
+    uint32_t getTotalEncoderCount();
+    uint32_t getTotalDistanceMillimeter();
     unsigned int getBrakingDistanceMillimeter();
 
     unsigned int getSpeed();
@@ -115,6 +144,8 @@ public:
     void resetEncoderMotorValues();
     void resetEncoderControlValues();
     void resetSpeedValues();
+    void setMillimeterPerCountQ8(uint16_t aMillimeterPerCountQ8);
+    unsigned int getSpeedScaleValue();
 
 #if defined(ENABLE_MOTOR_LIST_FUNCTIONS)
     void  AddToMotorList();
@@ -143,6 +174,21 @@ public:
     EncoderMotor * NextMotorControl;
 #endif
 
+    uint16_t MillimeterPerCountQ8; // Millimeter per encoder count * 256. 2816 for a 220 mm wheel and 20 encoder slots. Not reset by resetEncoderMotorValues().
+
+    /*
+     * 32 bit position, which is extended from the 16 bit EncoderCountFreeRunning by getTotalEncoderCount(), to keep the ISR short.
+     * getTotalEncoderCount() is called by updateMotor(), so it is called often enough, i.e. at least every 65535 counts (720 m).
+     */
+    volatile unsigned int EncoderCountFreeRunning; // Incremented at each encoder interrupt, never reset. Differences are wrap safe.
+    unsigned int LastEncoderCountFreeRunning;
+    uint32_t TotalEncoderCount;
+
+#if defined(ENABLE_TIMER_SCHEDULED_STOP)
+    volatile uint8_t ScheduledStopState;        // SCHEDULED_STOP_NONE, SCHEDULED_STOP_ARMED or SCHEDULED_STOP_BRAKED
+    volatile unsigned long ScheduledStopMillis; // Extrapolated millis of reaching TargetDistanceMillimeter
+#endif
+
     /**************************************************************
      * Variables required for going a fixed distance with encoder
      **************************************************************/
@@ -48,6 +48,7 @@ EncoderMotor *sPointerForInt1ISR;
 
 EncoderMotor::EncoderMotor() : // @suppress("Class members should be properly initialized")
         PWMDcMotor() {
+    MillimeterPerCountQ8 = FACTOR_COUNT_TO_MILLIMETER_Q8_DEFAULT;
 #if defined(ENABLE_MOTOR_LIST_FUNCTIONS)
     AddToMotorList();
 #endif
@@ -71,6 +72,7 @@ void EncoderMotor::init(uint8_t aMotorNumber, uint8_t aInterruptNumber) {
 #else
 EncoderMotor::EncoderMotor(uint8_t aForwardPin, uint8_t aBackwardPin, uint8_t aPWMPin) : // @suppress("Class members should be properly initialized")
         PWMDcMotor(aForwardPin, aBackwardPin, aPWMPin) {
+    MillimeterPerCountQ8 = FACTOR_COUNT_TO_MILLIMETER_Q8_DEFAULT;
     resetEncoderMotorValues();
 #if defined(ENABLE_MOTOR_LIST_FUNCTIONS)
     AddToMotorList();
@@ -152,13 +154,20 @@ void EncoderMotor::startGoDistanceMillimeterWithSpeed(uint8_t aRequestedSpeedPWM
 bool EncoderMotor::updateMotor() {
     unsigned long tMillis = millis();
     uint8_t tNewSpeedPWM = RequestedSpeedPWM;
+    getTotalEncoderCount(); // Extend the 16 bit free running count to 32 bit
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+    checkBacklashTakeUp();
+#endif
 
     /*
      * Check if target distance is reached or encoder tick has timeout
      */
     if (tNewSpeedPWM > 0) {
         if (CheckStopConditionInUpdateMotor
-                && (getDistanceMillimeter() >= TargetDistanceMillimeter
+                && (getInterpolatedDistanceMillimeter() >= TargetDistanceMillimeter
+#if defined(ENABLE_TIMER_SCHEDULED_STOP)
+                        || ScheduledStopState == SCHEDULED_STOP_BRAKED
+#endif
                         || tMillis > (LastEncoderInterruptMillis + ENCODER_SENSOR_TIMEOUT_MILLIS))) {
             /*
              * Stop now
@@ -185,6 +194,10 @@ bool EncoderMotor::updateMotor() {
 #if defined(DO_NOT_SUPPORT_RAMP)
     return false; // PWM is already 0, need no more calls to updateMotor()
 #else
+    if (MotorRampState == MOTOR_STATE_BLEND) {
+        return updateSpeedBlending();
+    }
+
     if (MotorRampState == MOTOR_STATE_START) {
         NextRampChangeMillis = tMillis + RAMP_INTERVAL_MILLIS;
         /*
@@ -213,13 +226,13 @@ bool EncoderMotor::updateMotor() {
              */
             if (tNewSpeedPWM == RequestedDriveSpeedPWM
                     || (CheckStopConditionInUpdateMotor
-                            && getDistanceMillimeter() + getBrakingDistanceMillimeter() >= TargetDistanceMillimeter)) {
+                            && getInterpolatedDistanceMillimeter() + getBrakingDistanceMillimeter() >= TargetDistanceMillimeter)) {
                 //  RequestedDriveSpeedPWM reached switch to --> DRIVE_SPEED_PWM and check immediately for next transition to RAMP_DOWN
                 MotorRampState = MOTOR_STATE_DRIVE;
             } else {
                 tNewSpeedPWM = tNewSpeedPWM + RAMP_UP_VALUE_DELTA;
                 // Clip value and check for 8 bit overflow
-                if (tNewSpeedPWM > RequestedDriveSpeedPWM || tNewSpeedPWM <= RAMP_UP_VALUE_DELTA) {
+                if (tNewSpeedPWM >= getRampEndSpeedPWM() || tNewSpeedPWM <= RAMP_UP_VALUE_DELTA) {
                     // do not change state here to let motor run at RequestedDriveSpeedPWM for one interval
                     tNewSpeedPWM = RequestedDriveSpeedPWM;
                 }
@@ -232,7 +245,7 @@ bool EncoderMotor::updateMotor() {
         /*
          * Wait until target distance - braking distance reached
          */
-        if (CheckStopConditionInUpdateMotor && (getDistanceMillimeter() + getBrakingDistanceMillimeter() >= TargetDistanceMillimeter)) {
+        if (CheckStopConditionInUpdateMotor && (getInterpolatedDistanceMillimeter() + getBrakingDistanceMillimeter() >= TargetDistanceMillimeter)) {
             if (RequestedSpeedPWM > RAMP_DOWN_VALUE_OFFSET_SPEED_PWM) {
                 tNewSpeedPWM -= (RAMP_DOWN_VALUE_OFFSET_SPEED_PWM - RAMP_DOWN_VALUE_DELTA); // RAMP_VALUE_DELTA is immediately subtracted below
             } else {
@@ -393,6 +406,9 @@ void EncoderMotor::resetSpeedValues() {
 }
 
 void EncoderMotor::resetEncoderControlValues() {
+#if defined(ENABLE_TIMER_SCHEDULED_STOP)
+    ScheduledStopState = SCHEDULED_STOP_NONE;
+#endif
     EncoderCount = 0;
     EncoderCountForSynchronize = 0;
     LastEncoderInterruptMillis = millis() - ENCODER_SENSOR_RING_MILLIS - 1; // Set to a sensible value to avoid initial timeout
@@ -438,12 +454,87 @@ uint8_t EncoderMotor::getDirection() {
     return CurrentDirection;
 }
 
+/*
+ * @param aMillimeterPerCountQ8 Millimeter per encoder count * 256, e.g. from calibration. Values out of plausible range are ignored.
+ */
+void EncoderMotor::setMillimeterPerCountQ8(uint16_t aMillimeterPerCountQ8) {
+    if (aMillimeterPerCountQ8 >= MILLIMETER_PER_COUNT_Q8_MIN && aMillimeterPerCountQ8 <= MILLIMETER_PER_COUNT_Q8_MAX) {
+        MillimeterPerCountQ8 = aMillimeterPerCountQ8;
+    }
+}
+
+/*
+ * The fractional part of MillimeterPerCountQ8 avoids the systematic error of an integer factor, which is 3% for the default 11 mm.
+ */
 unsigned int EncoderMotor::getDistanceMillimeter() {
-    return EncoderCount * FACTOR_COUNT_TO_MILLIMETER_INTEGER_DEFAULT; // * 11
+    return ((uint32_t) EncoderCount * MillimeterPerCountQ8) >> 8;
+}
+
+/*
+ * Adds the distance driven since the last encoder interrupt, extrapolated with the duration of the last encoder period.
+ * This reduces the quantization of 11 mm for 20 slots to around 1 mm at speeds below 1 m/s.
+ * The fraction is limited to less than one count, since the car has not yet reached the next slot.
+ * Without valid period, i.e. at start or after a timeout, it is equal to getDistanceMillimeter().
+ */
+unsigned int EncoderMotor::getInterpolatedDistanceMillimeter() {
+    noInterrupts();
+    unsigned int tEncoderCount = EncoderCount;
+    unsigned long tLastEncoderInterruptMillis = LastEncoderInterruptMillis;
+    unsigned long tEncoderInterruptDeltaMillis = EncoderInterruptDeltaMillis;
+    interrupts();
+
+    uint32_t tDistanceMillimeterQ8 = (uint32_t) tEncoderCount * MillimeterPerCountQ8;
+    if (tEncoderInterruptDeltaMillis != 0) {
+        unsigned long tMillisSinceLastInterrupt = millis() - tLastEncoderInterruptMillis;
+        if (tMillisSinceLastInterrupt >= tEncoderInterruptDeltaMillis) {
+            tMillisSinceLastInterrupt = tEncoderInterruptDeltaMillis - 1; // car is slowing down
+        }
+        tDistanceMillimeterQ8 += ((uint32_t) MillimeterPerCountQ8 * tMillisSinceLastInterrupt) / tEncoderInterruptDeltaMillis;
+    }
+    return tDistanceMillimeterQ8 >> 8;
 }
 
 unsigned int EncoderMotor::getDistanceCentimeter() {
-    return (EncoderCount * FACTOR_COUNT_TO_MILLIMETER_INTEGER_DEFAULT) / 10;
+    return ((uint32_t) EncoderCount * MillimeterPerCountQ8) / (256 * 10);
+}
+
+/*
+ * Read with interrupts disabled, since reading 16 bit is not atomic on 8 bit CPUs
+ * @return Count, which is never reset. Use unsigned difference to a former value to get counts in between.
+ */
+unsigned int EncoderMotor::getFreeRunningEncoderCount() {
+    noInterrupts();
+    unsigned int tEncoderCount = EncoderCountFreeRunning;
+    interrupts();
+    return tEncoderCount;
+}
+
+/*
+ * Extends EncoderCountFreeRunning to 32 bit. Must be called at least every 65535 encoder counts, which is done by updateMotor().
+ * @return Counts since boot, which overflows after 47000 km
+ */
+uint32_t EncoderMotor::getTotalEncoderCount() {
+    unsigned int tEncoderCount = getFreeRunningEncoderCount();
+    TotalEncoderCount += (unsigned int) (tEncoderCount - LastEncoderCountFreeRunning);
+    LastEncoderCountFreeRunning = tEncoderCount;
+    return TotalEncoderCount;
+}
+
+/*
+ * Split multiplication to avoid overflow of the 32 bit product for distances above 16 km
+ * @return Millimeter driven since boot
+ */
+uint32_t EncoderMotor::getTotalDistanceMillimeter() {
+    uint32_t tTotalEncoderCount = getTotalEncoderCount();
+    return ((tTotalEncoderCount >> 8) * MillimeterPerCountQ8) + (((tTotalEncoderCount & 0xFF) * MillimeterPerCountQ8) >> 8);
+}
+
+/*
+ * Value of SPEED_SCALE_VALUE for the current MillimeterPerCountQ8
+ * @return 100 * millimeter per count, to get cm/s from millis per count
+ */
+unsigned int EncoderMotor::getSpeedScaleValue() {
+    return ((uint32_t) MillimeterPerCountQ8 * 100) >> 8; // 1100
 }
 
 /*
@@ -468,7 +559,7 @@ unsigned int EncoderMotor::getSpeed() {
     if (tEncoderInterruptDeltaMillis == 0) {
         return 0;
     }
-    return (SPEED_SCALE_VALUE / tEncoderInterruptDeltaMillis);
+    return (getSpeedScaleValue() / tEncoderInterruptDeltaMillis);
 }
 
 /*
@@ -493,7 +584,7 @@ unsigned int EncoderMotor::getAverageSpeed() {
             tEncoderInterruptMillisArrayIndex--;
             if (tEncoderInterruptMillisArrayIndex > 0) {
                 // here MillisArray is not completely filled and EncoderInterruptMillisArrayIndex had no wrap around
-                tAverageSpeed = (SPEED_SCALE_VALUE * tEncoderInterruptMillisArrayIndex)
+                tAverageSpeed = ((long) getSpeedScaleValue() * tEncoderInterruptMillisArrayIndex)
                         / (EncoderInterruptMillisArray[tEncoderInterruptMillisArrayIndex] - EncoderInterruptMillisArray[0]);
             }
         } else {
@@ -506,7 +597,7 @@ unsigned int EncoderMotor::getAverageSpeed() {
                 // wrap around
                 tEncoderInterruptMillisArrayIndex = AVERAGE_SPEED_BUFFER_SIZE - 1;
             }
-            tAverageSpeed = (SPEED_SCALE_VALUE * AVERAGE_SPEED_SAMPLE_SIZE)
+            tAverageSpeed = ((long) getSpeedScaleValue() * AVERAGE_SPEED_SAMPLE_SIZE)
                     / (EncoderInterruptMillisArray[tEncoderInterruptMillisArrayIndex] - tOldestEncoderInterruptMillis);
         }
     }
@@ -533,7 +624,7 @@ unsigned int EncoderMotor::getAverageSpeed(uint8_t aLengthOfAverage) {
         // wrap around
         tHistoricIndex += AVERAGE_SPEED_BUFFER_SIZE;
     }
-    int tAverageSpeed = (SPEED_SCALE_VALUE * aLengthOfAverage)
+    int tAverageSpeed = ((long) getSpeedScaleValue() * aLengthOfAverage)
             / (LastEncoderInterruptMillis - EncoderInterruptMillisArray[tHistoricIndex]);
 
     return tAverageSpeed;
@@ -606,10 +697,61 @@ void EncoderMotor::handleEncoderInterrupt() {
 
         EncoderCount++;
         EncoderCountForSynchronize++;
+        EncoderCountFreeRunning++;
         SensorValuesHaveChanged = true;
+#if defined(ENABLE_TIMER_SCHEDULED_STOP)
+        if (CheckStopConditionInUpdateMotor && ScheduledStopState == SCHEDULED_STOP_NONE) {
+            scheduleStop(tMillis);
+        }
+#endif
+    }
+}
+
+#if defined(ENABLE_TIMER_SCHEDULED_STOP)
+/*
+ * Called by encoder ISR. If target distance is reached before the next encoder interrupt,
+ * compute the time of reaching it with the duration of the last encoder period, like getInterpolatedDistanceMillimeter() does,
+ * and enable the timer0 compare A interrupt, which brakes the motor at this time, even if loop is blocked.
+ */
+void EncoderMotor::scheduleStop(unsigned long aEncoderInterruptMillis) {
+    uint32_t tDistanceMillimeterQ8 = (uint32_t) EncoderCount * MillimeterPerCountQ8;
+    uint32_t tTargetDistanceMillimeterQ8 = (uint32_t) TargetDistanceMillimeter << 8;
+    if (EncoderInterruptDeltaMillis == 0 || tDistanceMillimeterQ8 + MillimeterPerCountQ8 <= tTargetDistanceMillimeterQ8) {
+        return; // No valid speed or target not reached in the current encoder period
     }
+    unsigned long tMillisToTarget = 0;
+    if (tDistanceMillimeterQ8 < tTargetDistanceMillimeterQ8) {
+        tMillisToTarget = ((tTargetDistanceMillimeterQ8 - tDistanceMillimeterQ8) * EncoderInterruptDeltaMillis) / MillimeterPerCountQ8;
+    }
+    ScheduledStopMillis = aEncoderInterruptMillis + tMillisToTarget;
+    ScheduledStopState = SCHEDULED_STOP_ARMED;
+    TIFR0 = _BV(OCF0A); // Clear pending interrupt
+    TIMSK0 |= _BV(OCIE0A);
 }
 
+/*
+ * Called by timer0 compare A ISR every 1.024 ms. Brakes the motor without Serial output, the rest is done by stop() in updateMotor().
+ * @return true if stop is still armed
+ */
+bool EncoderMotor::checkScheduledStop() {
+    if (ScheduledStopState != SCHEDULED_STOP_ARMED) {
+        return false;
+    }
+    if (!CheckStopConditionInUpdateMotor) {
+        // Motor was stopped or got a new command without target distance in between
+        ScheduledStopState = SCHEDULED_STOP_NONE;
+        return false;
+    }
+    if ((long) (millis() - ScheduledStopMillis) < 0) {
+        return true;
+    }
+    writeSpeedPWM(0);
+    setMotorDriverMode(STOP_MODE_BRAKE);
+    ScheduledStopState = SCHEDULED_STOP_BRAKED;
+    return false;
+}
+#endif
+
 #if defined(INT0_vect)
 // ISR for PIN PD2 / RIGHT
 ISR(INT0_vect) {
@@ -622,6 +764,25 @@ ISR(INT1_vect) {
 }
 #endif
 
+#if defined(ENABLE_TIMER_SCHEDULED_STOP)
+/*
+ * Timer0 is the millis() timer, which is never reprogrammed, so this interrupt comes every 1.024 ms.
+ * It is only enabled while a stop is armed.
+ */
+ISR(TIMER0_COMPA_vect) {
+    bool tStopIsArmed = false;
+    if (sPointerForInt0ISR != NULL) {
+        tStopIsArmed = sPointerForInt0ISR->checkScheduledStop();
+    }
+    if (sPointerForInt1ISR != NULL) {
+        tStopIsArmed |= sPointerForInt1ISR->checkScheduledStop();
+    }
+    if (!tStopIsArmed) {
+        TIMSK0 &= ~_BV(OCIE0A);
+    }
+}
+#endif
+
 /******************************************************************************************
  * Static methods
  *****************************************************************************************/
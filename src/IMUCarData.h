@@ -61,9 +61,31 @@ extern bool sOnlyPlotterOutput; // from main program
 #endif
 #define SAMPLE_RATE_DIVIDER             DELAY_TO_NEXT_IMU_DATA_MILLIS // we have a clock of 1000 Hz :-)
 
+#if defined(ENABLE_IMU_EVENT_DETECTION)
+/*
+ * Events are detected for each FIFO sample. Thresholds are raw values for 2 g range, 16384 is 1 g.
+ */
+#define IMU_EVENT_COLLISION     0x01 // Forward acceleration jumps away from its low pass value, e.g. at hitting an obstacle
+#define IMU_EVENT_LIFT_OFF      0x02 // Vertical acceleration is much bigger than 1 g or car is falling, e.g. car is lifted up or dropped
+#define IMU_EVENT_TIP_OVER      0x04 // Car is tilted more than 45 degree for IMU_EVENT_TIP_OVER_SAMPLES
+
+#if !defined(IMU_EVENT_COLLISION_THRESHOLD)
+#define IMU_EVENT_COLLISION_THRESHOLD   8192 // 0.5 g deviation of forward acceleration from its low pass value
+#endif
+#if !defined(IMU_EVENT_LIFT_OFF_THRESHOLD)
+#define IMU_EVENT_LIFT_OFF_THRESHOLD    8192 // 0.5 g more than 1 g vertical acceleration
+#endif
+#if !defined(IMU_EVENT_FREE_FALL_THRESHOLD)
+#define IMU_EVENT_FREE_FALL_THRESHOLD   6554 // 0.4 g total acceleration
+#endif
+#define IMU_EVENT_TIP_OVER_THRESHOLD   11585 // cos(45 degree) * 1 g vertical acceleration
+#define IMU_EVENT_TIP_OVER_SAMPLES      (SAMPLE_RATE / 10) // 100 ms, to ignore bumps
+#endif
+
 #define NUMBER_OF_OFFSET_CALIBRATION_SAMPLES    (SAMPLE_RATE / 2) // so it takes always 1/2 second for offset recalculation
 
 // independent of SAMPLE_RATE
+#define ACCEL_RAW_FOR_1G_FOR_2G_RANGE 16384
 #define ACCEL_RAW_TO_G_FOR_2G_RANGE (4.0/65536.0)
 #define GYRO_RAW_TO_DEGREE_PER_SECOND_FOR_250DPS_RANGE (500.0/65536.0) // 0.00762939 or 1/131.072
 
@@ -113,6 +135,11 @@ public:
 
     void printSpeedAndTurnOffsets(Print *aSerial);
 
+#if defined(ENABLE_IMU_EVENT_DETECTION)
+    void detectEvents(int16_t aAcceleratorForward, int16_t aAcceleratorSideways, int16_t aAcceleratorVertical);
+    uint8_t getAndClearEvents();
+#endif
+
     /*
      * Functions copied from MPU6050IMUData
      */
@@ -159,6 +186,13 @@ public:
     LongUnion TurnAngle;
     uint32_t LastFifoCheckMillis;
 
+#if defined(ENABLE_IMU_EVENT_DETECTION)
+    uint8_t Events;                 // Bit set of IMU_EVENT_*, cleared by getAndClearEvents()
+    uint8_t NewEvents;              // Events detected in the current FIFO read, they are passed to EventCallback as long as they persist
+    uint8_t TipOverSampleCount;
+    void (*EventCallback)(uint8_t aNewEvents); // Called at the end of the FIFO read, in which the events were detected
+#endif
+
     /*
      * Variables for doOffsetRecalculation
      */
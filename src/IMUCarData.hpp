@@ -206,6 +206,9 @@ bool IMUCarData::readCarDataFromMPU6050Fifo() {
             Wire.endTransmission(false);
             // read chunk by chunk
             Wire.requestFrom((uint8_t) MPU6050_DEFAULT_ADDRESS, (uint8_t) (FIFO_CHUNK_SIZE_FOR_CAR_DATA), (uint8_t) true);
+#endif
+#if defined(ENABLE_IMU_EVENT_DETECTION)
+            int16_t tAcceleratorValues[NUMBER_OF_ACCEL_VALUES];
 #endif
             /*
              * We must read all 3 accelerator values
@@ -241,7 +244,17 @@ bool IMUCarData::readCarDataFromMPU6050Fifo() {
                     Speed.Long += tAcceleratorValue.Word;
                     Distance.Long += Speed.Long >> 8;
                 }
+#if defined(ENABLE_IMU_EVENT_DETECTION)
+                tAcceleratorValues[i] = tAcceleratorValue.Word;
+#endif
             }
+#if defined(ENABLE_IMU_EVENT_DETECTION)
+#  if defined(USE_ACCELERATOR_Y_FOR_SPEED)
+            detectEvents(tAcceleratorValues[1], tAcceleratorValues[0], tAcceleratorValues[2]);
+#  else
+            detectEvents(tAcceleratorValues[0], tAcceleratorValues[1], tAcceleratorValues[2]);
+#  endif
+#endif
             /*
              * Now the Gyro value
              */
@@ -261,6 +274,17 @@ bool IMUCarData::readCarDataFromMPU6050Fifo() {
         } // for (tChunckCount = 0; tChunckCount < tNumberOfChunks; tChunckCount++)
 #if defined(USE_SOFT_I2C_MASTER)
         i2c_stop();
+#endif
+#if defined(ENABLE_IMU_EVENT_DETECTION)
+        /*
+         * Call it after i2c_stop(), since the callback may use I2C, e.g. to stop the motors of the Adafruit motor shield
+         */
+        if (NewEvents != 0) {
+            if (EventCallback != NULL) {
+                EventCallback(NewEvents);
+            }
+            NewEvents = 0;
+        }
 #endif
         CountOfFifoChunksForOffset += tNumberOfChunks;
         // compute average of read values
@@ -299,6 +323,56 @@ bool IMUCarData::readCarDataFromMPU6050Fifo() {
     return true;
 }
 
+#if defined(ENABLE_IMU_EVENT_DETECTION)
+/*
+ * Checks one FIFO sample for collision, lift off and tip over.
+ * Free fall and tilt both reduce the vertical acceleration, they are distinguished by the total acceleration.
+ * @param aAcceleratorForward Offset compensated forward acceleration
+ */
+void IMUCarData::detectEvents(int16_t aAcceleratorForward, int16_t aAcceleratorSideways, int16_t aAcceleratorVertical) {
+    uint8_t tEvents = 0;
+    if (AcceleratorForwardOffset != 0) {
+        // Low pass value is required for collision detection
+        int32_t tAcceleratorForwardHighPass = (int32_t) aAcceleratorForward - AcceleratorForwardLowPass6.Word.HighWord;
+        if (tAcceleratorForwardHighPass > IMU_EVENT_COLLISION_THRESHOLD
+                || tAcceleratorForwardHighPass < -IMU_EVENT_COLLISION_THRESHOLD) {
+            tEvents = IMU_EVENT_COLLISION;
+        }
+    }
+
+    int32_t tAcceleratorVertical = abs((int32_t) aAcceleratorVertical); // sensor may be mounted head down
+    if (tAcceleratorVertical > ACCEL_RAW_FOR_1G_FOR_2G_RANGE + IMU_EVENT_LIFT_OFF_THRESHOLD) {
+        tEvents |= IMU_EVENT_LIFT_OFF;
+    }
+    if (tAcceleratorVertical < IMU_EVENT_TIP_OVER_THRESHOLD) {
+        uint32_t tSquaredAcceleration = (uint32_t) ((int32_t) aAcceleratorForward * aAcceleratorForward)
+                + (uint32_t) ((int32_t) aAcceleratorSideways * aAcceleratorSideways)
+                + (uint32_t) (tAcceleratorVertical * tAcceleratorVertical);
+        if (tSquaredAcceleration < (uint32_t) IMU_EVENT_FREE_FALL_THRESHOLD * IMU_EVENT_FREE_FALL_THRESHOLD) {
+            tEvents |= IMU_EVENT_LIFT_OFF;
+        } else if (TipOverSampleCount < IMU_EVENT_TIP_OVER_SAMPLES) {
+            TipOverSampleCount++;
+        } else {
+            tEvents |= IMU_EVENT_TIP_OVER;
+        }
+    } else {
+        TipOverSampleCount = 0;
+    }
+
+    NewEvents |= tEvents;
+    Events |= tEvents;
+}
+
+/*
+ * @return Bit set of all IMU_EVENT_* detected since last call
+ */
+uint8_t IMUCarData::getAndClearEvents() {
+    uint8_t tEvents = Events;
+    Events = 0;
+    return tEvents;
+}
+#endif
+
 /*
  * Automatic offset recalculation is done, if we do not detect any movement for NUMBER_OF_OFFSET_CALIBRATION_SAMPLES samples.
  * Initial offset is required to detect movement.
@@ -93,6 +93,7 @@ public:
             void (*aLoopCallback)(void) = NULL);
 
     bool updateMotors();    bool updateMotors(void (*aLoopCallback)(void));
+    void synchronizeMotorsWithRightMotor(); // used internally
 
     void delayAndUpdateMotors(unsigned int aDelayMillis);
 
@@ -117,6 +118,7 @@ public:
     void setDirection(uint8_t aRequestedDirection);
 
     void setSpeedPWMAndDirection(int aRequestedSpeedPWM);
+    void setSpeedPWM(int aSignedRequestedSpeedPWMForLeftMotor, int aSignedRequestedSpeedPWMForRightMotor); // Left and right wheel pairs, disables motor following
     void setSpeedPWMAndDirection(uint8_t aRequestedSpeedPWM, uint8_t aRequestedDirection);
     void setSpeedPWMWithDeltaAndDirection(uint8_t aRequestedSpeedPWM, uint8_t aRequestedDirection, int8_t aSpeedPWMCompensationRightDelta);
     void changeSpeedPWM(uint8_t aRequestedSpeedPWM); // Keeps direction
@@ -146,6 +148,7 @@ public:
 
     PWMDcMotor backRightCarMotor;
     PWMDcMotor backLeftCarMotor;
+    bool MotorsFollowRightMotor;    // Set by setDirection(), reset by stop() and setSpeedPWM(left, right). All motors follow the ramp of the right motor
 };
 
 extern MecanumWheelCarPWMMotorControl RobotCar;
@@ -94,6 +94,7 @@ void MecanumWheelCarPWMMotorControl::stop(uint8_t aStopMode) {
     backRightCarMotor.stop(aStopMode);
     backLeftCarMotor.stop(aStopMode);
     CarDirection = DIRECTION_STOP;
+    MotorsFollowRightMotor = false;
 }
 
 /*
@@ -183,6 +184,7 @@ void MecanumWheelCarPWMMotorControl::setSpeedPWMAndDirection(uint8_t aRequestedS
     checkAndHandleDirectionChange(aRequestedDirection);
     setDirection(aRequestedDirection); // sets direction for all 4 motors
     rightCarMotor.setSpeedPWM(aRequestedSpeedPWM);
+    synchronizeMotorsWithRightMotor();
 }
 
 /**
@@ -204,6 +206,7 @@ void MecanumWheelCarPWMMotorControl::setSpeedPWMAndDirectionAndDelay(uint8_t aRe
  */
 void MecanumWheelCarPWMMotorControl::changeSpeedPWM(uint8_t aRequestedSpeedPWM) {
     rightCarMotor.changeSpeedPWM(aRequestedSpeedPWM);
+    synchronizeMotorsWithRightMotor();
 }
 
 /*
@@ -216,6 +219,7 @@ void MecanumWheelCarPWMMotorControl::setSpeedPWMWithDeltaAndDirection(uint8_t aR
     setDirection(aRequestedDirection); // sets direction for all 4 motors
     rightCarMotor.setSpeedPWM(aRequestedSpeedPWM);
     (void) aSpeedPWMCompensationRightDelta;
+    synchronizeMotorsWithRightMotor();
 }
 
 /*
@@ -314,10 +318,23 @@ void MecanumWheelCarPWMMotorControl::setDirection(uint8_t aRequestedDirection) {
         rightCarMotor.setDirection(tFrontRightMotorDirection);
         backRightCarMotor.setDirection(tBackRightMotorDirection);
     }
+    MotorsFollowRightMotor = true;
 }
 
 void MecanumWheelCarPWMMotorControl::setSpeedPWM(uint8_t aRequestedSpeedPWM) {
     rightCarMotor.setSpeedPWM(aRequestedSpeedPWM);
+    synchronizeMotorsWithRightMotor();
+}
+
+/*
+ * Sets speed and direction for the left and right wheel pairs e.g. for steering by CarPathFollower.
+ * Disables following of the right motor, otherwise updateMotors() would overwrite the left speeds.
+ */
+void MecanumWheelCarPWMMotorControl::setSpeedPWM(int aSignedRequestedSpeedPWMForLeftMotor, int aSignedRequestedSpeedPWMForRightMotor) {
+    MotorsFollowRightMotor = false;
+    backRightCarMotor.setSpeedPWMAndDirection(aSignedRequestedSpeedPWMForRightMotor);
+    backLeftCarMotor.setSpeedPWMAndDirection(aSignedRequestedSpeedPWMForLeftMotor);
+    CarPWMMotorControl::setSpeedPWM(aSignedRequestedSpeedPWMForLeftMotor, aSignedRequestedSpeedPWMForRightMotor);
 }
 
 void MecanumWheelCarPWMMotorControl::setSpeedPWMAndDirection(int aRequestedSpeedPWM) {
@@ -352,15 +369,50 @@ void MecanumWheelCarPWMMotorControl::writeMotorValuesToEeprom() {
  */
 bool MecanumWheelCarPWMMotorControl::updateMotors() {
 #if defined(USE_MPU6050_IMU)
-    CarPWMMotorControl::updateMotors();
+    bool tReturnValue = CarPWMMotorControl::updateMotors();
 #else // USE_MPU6050_IMU
     bool tReturnValue = rightCarMotor.updateMotor();
     if (!tReturnValue && rightCarMotor.MotorPWMHasChanged) {
         stop(); // stop all other motors too, if right car motor was just stopped
     }
 #endif // USE_MPU6050_IMU
+    synchronizeMotorsWithRightMotor();
 
-    return tReturnValue;;
+    return tReturnValue;
+}
+
+#if defined(USE_ADAFRUIT_MOTOR_SHIELD)
+/*
+ * Only driven wheels follow, wheels set to STOP_MODE_BRAKE by setDirection() keep braking
+ */
+static void setFollowerMotorSpeedPWM(PWMDcMotor *aMotor, uint8_t aSpeedPWM) {
+    if ((aMotor->CurrentDirection == DIRECTION_FORWARD || aMotor->CurrentDirection == DIRECTION_BACKWARD)
+            && aMotor->RequestedSpeedPWM != aSpeedPWM) {
+        aMotor->setSpeedPWM(aSpeedPWM);
+    }
+}
+#endif
+
+/*
+ * Ramps are only computed for the right motor. All other motors get the same speed in the same update, so the speed ratio
+ * of the movement, which is 1 for driven and 0 for braked wheels, is kept during ramp up and ramp down, and all motors stop together.
+ * For the full bridge all 4 motors share one PWM pin and only the stop must be synchronized.
+ * Active from setDirection() until stop() or setSpeedPWM(left, right). Call stop() before setting the speed of single motors.
+ */
+void MecanumWheelCarPWMMotorControl::synchronizeMotorsWithRightMotor() {
+    if (!MotorsFollowRightMotor) {
+        return; // motors are controlled individually, e.g. by CarPathFollower
+    }
+    uint8_t tSpeedPWM = rightCarMotor.RequestedSpeedPWM;
+    if (tSpeedPWM == 0) {
+        stop(); // e.g. after CarPWMMotorControl::updateMotors() has stopped only the front motors
+        return;
+    }
+#if defined(USE_ADAFRUIT_MOTOR_SHIELD)
+    setFollowerMotorSpeedPWM(&leftCarMotor, tSpeedPWM);
+    setFollowerMotorSpeedPWM(&backRightCarMotor, tSpeedPWM);
+    setFollowerMotorSpeedPWM(&backLeftCarMotor, tSpeedPWM);
+#endif
 }
 
 /*
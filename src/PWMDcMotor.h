@@ -65,10 +65,14 @@
 //#define VIN_1_LI_ION                    // If you use a mosfet bridge (TB6612), 1 Li-ion cell (around 3.7 volt) may be sufficient.
 //#define FULL_BRIDGE_INPUT_MILLIVOLT 6000// Default. For 4 x AA batteries (6 volt).
 //#define USE_L298_BRIDGE                 // Activate this, if you use a L298 bridge, which has higher losses than a recommended mosfet bridge like TB6612.
+//#define USE_DRV8833_BRIDGE              // Activate this, if you use a DRV8833 bridge, which has no enable pin. PWM is generated at the direction pins.
+//#define ENABLE_DECAY_MODE_SELECTION     // Enables setDecayMode() to generate PWM at the direction pins, which must then be PWM capable.
+//#define ENABLE_BACKLASH_COMPENSATION    // After a direction reversal, the motor gets a take up pulse of BacklashTakeUpMillis to close the gear play. Requires calls to updateMotor().
 //#define DEFAULT_DRIVE_MILLIVOLT   2000  // Drive voltage / motors default speed. Default value is 2.0 volt.
 //#define DO_NOT_SUPPORT_RAMP             // Ramps are anyway not used if drive speed voltage (default 2.0 V) is below 2.3 V. Saves 378 bytes program memory.
 //#define DO_NOT_SUPPORT_AVERAGE_SPEED    // Disables the encoder function getAverageSpeed(). Saves 44 bytes RAM per motor and 156 bytes program memory.
 //#define USE_STANDARD_LIBRARY_FOR_ADAFRUIT_MOTOR_SHIELD // Activate this to force using of Adafruit library. Requires 694 bytes program memory.
+//#define USE_PHASE_SHIFTED_MOTOR_PWM     // The PWM pulse of the B channel of a timer (e.g. pin 5) / of motor 2 of Adafruit shield is at the end of the period. Reduces battery current peaks.
 #if !defined(USE_STANDARD_LIBRARY_FOR_ADAFRUIT_MOTOR_SHIELD)
 #define _USE_OWN_LIBRARY_FOR_ADAFRUIT_MOTOR_SHIELD // to avoid double negations
 #endif
@@ -175,6 +179,15 @@
 #  endif
 #endif
 
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+#  if !defined(BACKLASH_TAKE_UP_MILLIVOLT)
+#define BACKLASH_TAKE_UP_MILLIVOLT          3000 // Minimum voltage during take up pulse
+#  endif
+#define _BACKLASH_TAKE_UP_SPEED_PWM         (((BACKLASH_TAKE_UP_MILLIVOLT * MAX_SPEED_PWM) + (FULL_BRIDGE_OUTPUT_MILLIVOLT / 2)) / FULL_BRIDGE_OUTPUT_MILLIVOLT)
+#define BACKLASH_TAKE_UP_SPEED_PWM          (_BACKLASH_TAKE_UP_SPEED_PWM > MAX_SPEED_PWM ? MAX_SPEED_PWM : _BACKLASH_TAKE_UP_SPEED_PWM)
+#define BACKLASH_MAX_TAKE_UP_MILLIS         100
+#endif
+
 /********************************************
  * PWM to voltage conversion
  ********************************************/
@@ -228,6 +241,19 @@
 #endif
 #define RAMP_DECELERATION_TIMES_2        (2000 * 2) // 2000 was measured by IMU for 14V/s and 2500 mV offset.
 
+/*
+ * Default values for speed blending by setSpeedPWMAndDirectionSmooth(). Values are PWM steps per RAMP_INTERVAL_MILLIS.
+ */
+#if !defined(BLEND_ACCELERATION_VALUE_DELTA)
+#define BLEND_ACCELERATION_VALUE_DELTA   RAMP_UP_VALUE_DELTA
+#endif
+#if !defined(BLEND_DECELERATION_VALUE_DELTA)
+#define BLEND_DECELERATION_VALUE_DELTA   RAMP_DOWN_VALUE_DELTA
+#endif
+#if !defined(BLEND_DIRECTION_CHANGE_DWELL_MILLIS)
+#define BLEND_DIRECTION_CHANGE_DWELL_MILLIS  40 // Motor is braked for this time at direction change to let it stop and to protect the full bridge
+#endif
+
 /********************************************
  * Program defines
  ********************************************/
@@ -245,6 +271,39 @@
 #define DEFAULT_STOP_MODE               STOP_MODE_BRAKE
 #define STOP_MODE_KEEP                  1 // Take DefaultStopMode - used only as parameter for stop()
 
+/*
+ * Decay mode is the state of the bridge in the PWM off phase.
+ * Slow decay shortens the motor (brake), which gives a more linear PWM to speed relation and more torque at low speed.
+ * Fast decay disconnects the motor (coast), the current decays through the diodes against the supply voltage.
+ * The decay mode of PWM at the enable pin is given by the driver, the other mode is realized by PWM at the direction pins.
+ *            PWM at enable pin   PWM at active direction pin   Inverted PWM at other direction pin
+ * TB6612     slow                fast                          -
+ * L298       fast                slow (enable is high)         -
+ * DRV8833    - (no enable pin)   fast                          slow
+ */
+#define DECAY_MODE_SLOW                 0
+#define DECAY_MODE_FAST                 1
+#if defined(USE_DRV8833_BRIDGE)
+#  if !defined(ENABLE_DECAY_MODE_SELECTION)
+#define ENABLE_DECAY_MODE_SELECTION
+#  endif
+#define DECAY_MODE_OF_ENABLE_PIN_PWM    0xFF // Not available
+#define DEFAULT_DECAY_MODE              DECAY_MODE_SLOW
+#elif defined(USE_L298_BRIDGE)
+#define DECAY_MODE_OF_ENABLE_PIN_PWM    DECAY_MODE_FAST
+#define DEFAULT_DECAY_MODE              DECAY_MODE_FAST
+#else
+#define DECAY_MODE_OF_ENABLE_PIN_PWM    DECAY_MODE_SLOW // TB6612 and Adafruit Motor Shield
+#define DEFAULT_DECAY_MODE              DECAY_MODE_SLOW
+#endif
+#if defined(ENABLE_DECAY_MODE_SELECTION) && defined(USE_ADAFRUIT_MOTOR_SHIELD) && !defined(_USE_OWN_LIBRARY_FOR_ADAFRUIT_MOTOR_SHIELD)
+#error ENABLE_DECAY_MODE_SELECTION is not supported for the standard Adafruit Motor Shield library
+#endif
+#if defined(ENABLE_DECAY_MODE_SELECTION) && defined(USE_PHASE_SHIFTED_MOTOR_PWM)
+// PWM at the direction pins is written without phase shift, so both motors would have their pulses at the same time again
+#error USE_PHASE_SHIFTED_MOTOR_PWM is not supported together with ENABLE_DECAY_MODE_SELECTION or USE_DRV8833_BRIDGE
+#endif
+
 /*
  * Extension for mecanum wheel movements
  * They are coded as bit positions in the upper nibble
@@ -309,6 +368,7 @@ struct EepromMotorInfoStruct {
 #define MOTOR_STATE_DRIVE       3
 #define MOTOR_STATE_RAMP_DOWN   4
 #define MOTOR_STATE_CHECK_DISTANCE 5
+#define MOTOR_STATE_BLEND       6 // Rate limited change of speed and direction to BlendTargetSpeedPWM, set by setSpeedPWMAndDirectionSmooth()
 
 class PWMDcMotor {
 public:
@@ -341,6 +401,8 @@ public:
     void changeSpeedPWM(uint8_t aRequestedSpeedPWM); // Keeps direction
     void setSpeedPWMAndDirection(uint8_t aRequestedSpeedPWM, uint8_t aRequestedDirection);
     void setSpeedPWMAndDirectionWithRamp(uint8_t aRequestedSpeedPWM, uint8_t aRequestedDirection);
+    void setSpeedPWMAndDirectionSmooth(int aSignedRequestedSpeedPWM); // Speed and direction change with acceleration limits, requires updateMotor()
+    void setBlendAccelerationAndDeceleration(uint8_t aAccelerationValueDelta, uint8_t aDecelerationValueDelta);
 
     void setSpeedPWMCompensation(uint8_t aSpeedPWMCompensation);
 
@@ -355,6 +417,16 @@ public:
     void start(uint8_t aRequestedDirection);
     void stop(uint8_t aStopMode = STOP_MODE_KEEP); // STOP_MODE_KEEP (take previously defined DefaultStopMode) or STOP_MODE_BRAKE or STOP_MODE_RELEASE
     void setStopMode(uint8_t aStopMode); // mode for SpeedPWM==0 or STOP_MODE_KEEP: STOP_MODE_BRAKE or STOP_MODE_RELEASE
+#if defined(ENABLE_POWER_MANAGEMENT)
+    void applySpeedPWMLimit(); // Sets RequestedSpeedPWM again to apply the changed SpeedPWMLimit
+#endif
+#if defined(ENABLE_DECAY_MODE_SELECTION)
+    void setDecayMode(uint8_t aDecayMode); // DECAY_MODE_SLOW or DECAY_MODE_FAST
+#endif
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+    void setBacklashTakeUpMillis(uint8_t aBacklashTakeUpMillis); // 0 disables compensation
+    void checkBacklashTakeUp();
+#endif
     bool isStopped(); // checks for SpeedPWM==0
     /*
      * Fixed distance driving functions
@@ -369,6 +441,10 @@ public:
     void startRampUp(uint8_t aRequestedDirection);
     void startRampDown();
     void synchronizeRampDown(PWMDcMotor *aOtherMotorControl);
+#if !defined(DO_NOT_SUPPORT_RAMP)
+    uint8_t getRampEndSpeedPWM();
+#endif
+    bool updateSpeedBlending();
 
 #if !defined(USE_ENCODER_MOTOR_CONTROL) // Guard required here, since we cannot access the computedMillisOfMotorStopForDistance and MillisPerCentimeter for the functions below
     // This function only makes sense for non encoder motors
@@ -411,6 +487,10 @@ public:
      * Internal functions
      */
     void setMotorDriverMode(uint8_t aMotorDriverMode);
+    void writeSpeedPWM(uint8_t aCompensatedSpeedPWM);
+#if defined(ENABLE_DECAY_MODE_SELECTION)
+    void writeSpeedPWMToDirectionPins(uint8_t aCompensatedSpeedPWM);
+#endif
     bool checkAndHandleDirectionChange(uint8_t aRequestedDirection);
 
 #if ! defined(USE_ADAFRUIT_MOTOR_SHIELD) || defined(_USE_OWN_LIBRARY_FOR_ADAFRUIT_MOTOR_SHIELD)
@@ -429,6 +509,15 @@ public:
      * End of EEPROM values
      *********************************/
     uint8_t DefaultStopMode;        // used for PWM == 0 and STOP_MODE_KEEP
+#if defined(ENABLE_DECAY_MODE_SELECTION)
+    uint8_t DecayMode;              // DECAY_MODE_SLOW or DECAY_MODE_FAST
+#endif
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+    uint8_t BacklashTakeUpMillis;   // Duration of take up pulse with BACKLASH_TAKE_UP_SPEED_PWM after a direction reversal
+    uint8_t LastDrivingDirection;   // DIRECTION_FORWARD or DIRECTION_BACKWARD, DIRECTION_STOP before first start
+    bool BacklashTakeUpIsActive;
+    unsigned long BacklashTakeUpStartMillis;
+#endif
     static bool MotorControlValuesHaveChanged; // true if DefaultStopMode, DriveSpeedPWM or SpeedPWMCompensation have changed - for printing
 #if defined(USE_MPU6050_IMU) || defined(USE_ENCODER_MOTOR_CONTROL)
     volatile static bool SensorValuesHaveChanged; // true if encoder data or IMU data have changed
@@ -444,6 +533,9 @@ public:
     uint8_t CurrentCompensatedSpeedPWM; // RequestedSpeedPWM - SpeedPWMCompensation.
     uint8_t CurrentDirection; // Used for speed and distance. Contains DIRECTION_FORWARD, DIRECTION_BACKWARD but NOT STOP_MODE_BRAKE, STOP_MODE_RELEASE.
     static bool MotorPWMHasChanged;
+#if defined(ENABLE_POWER_MANAGEMENT)
+    static uint8_t SpeedPWMLimit; // Upper limit for RequestedSpeedPWM, set by CarPowerManager to avoid brown out
+#endif
     bool CheckStopConditionInUpdateMotor;
 
 #if !defined(DO_NOT_SUPPORT_RAMP)
@@ -454,6 +546,13 @@ public:
     uint8_t RequestedDriveSpeedPWM; // DriveSpeedPWM - SpeedPWMCompensation; The DriveSpeedPWM used for current movement. Can be set for eg. turning which better performs with reduced DriveSpeedPWM
 
     unsigned long NextRampChangeMillis;
+
+    /*
+     * For speed blending
+     */
+    int16_t BlendTargetSpeedPWM;            // Signed speed, negative is backward
+    uint8_t BlendAccelerationValueDelta;    // Max PWM increase per RAMP_INTERVAL_MILLIS
+    uint8_t BlendDecelerationValueDelta;    // Max PWM decrease per RAMP_INTERVAL_MILLIS
 #endif
 
 #if !defined(USE_ENCODER_MOTOR_CONTROL) // this saves 5 bytes ram if we know, that we do not use the simple PWMDcMotor distance functions
@@ -470,6 +569,31 @@ public:
  * - Added 2 functions startGoDistanceMillimeterWithSpeed(uint8_t aRequestedSpeedPWM, ...).
  * - ESP32 core 3.x support.
  * - Improved examples, especially follower examples.
+ * - Added CarRouteRecorder for recording and replay of routes, enabled by ENABLE_ROUTE_RECORDING.
+ * - Added startGoArc() and goArc() for driving arcs with a given radius.
+ * - Added CarOdometry and pure pursuit CarPathFollower for encoder cars.
+ * - Added setSpeedPWMAndDirectionSmooth() for rate limited speed and direction changes while moving.
+ * - Added CarPowerManager for limiting PWM by predicted VIN sag, enabled by ENABLE_POWER_MANAGEMENT.
+ * - Examples: Added multi zone measurement for VL53L1X ToF sensor, enabled by TOF_USE_MULTI_ZONE.
+ * - Examples: Added speed adaptive scan for autonomous drive, enabled by ENABLE_ADAPTIVE_SCAN.
+ * - Examples: Added time to collision based braking, enabled by ENABLE_COLLISION_GUARD.
+ * - Examples: Added obstacle aware speed governor, enabled by ENABLE_SPEED_GOVERNOR.
+ * - Examples: Added double buffered non blocking distance scan, enabled by ENABLE_PIPELINED_SCAN.
+ * - Examples: Added servo target tracking for follower, enabled by ENABLE_TARGET_TRACKING.
+ * - Examples: Added scan by rotating the car in place for cars without distance servo, enabled by ENABLE_ROTATION_SCAN.
+ * - Examples: Added wall following and corridor centering with PD control, enabled by ENABLE_WALL_FOLLOWING.
+ * - Added CarCoveragePlanner for boustrophedon coverage of an area with visited cell bitmap.
+ * - Added collision, lift off and tip over detection in IMU FIFO processing, enabled by ENABLE_IMU_EVENT_DETECTION.
+ * - Mecanum wheel car: All 4 motors follow the ramp of the right motor in the same update and stop together.
+ * - Fractional millimeter per count value for each encoder motor, stored in EEPROM and calibrated by driving towards a wall.
+ * - 32 bit total encoder count and distance, extended from a free running 16 bit count, which is now used by CarOdometry.
+ * - RobotCarBlueDisplay example: Replaced sprintf_P() by small formatting functions from FormatUtils.hpp.
+ * - Added CarBackEMFSpeedControl for closed loop speed control of cars without encoders.
+ * - Added USE_PHASE_SHIFTED_MOTOR_PWM to shift the PWM pulses of both motors against each other.
+ * - Added ENABLE_DECAY_MODE_SELECTION, setDecayMode() and USE_DRV8833_BRIDGE.
+ * - Added getInterpolatedDistanceMillimeter() and use it for stop decisions of encoder motors.
+ * - Added ENABLE_TIMER_SCHEDULED_STOP to brake encoder motors at target distance by timer interrupt.
+ * - Added ENABLE_BACKLASH_COMPENSATION with take up pulse after direction reversal and calibration with IMU.
  *
  * Version 2.1.0 - 09/2023
  * - Added convertMillimeterToMillis() etc.
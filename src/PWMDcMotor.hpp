@@ -68,6 +68,9 @@ volatile bool PWMDcMotor::SensorValuesHaveChanged; // true if encoder count and
 #endif
 bool PWMDcMotor::MotorControlValuesHaveChanged; // true if DefaultStopMode, DriveSpeedPWM or SpeedPWMCompensation have changed
 bool PWMDcMotor::MotorPWMHasChanged;              // true if CurrentCompensatedSpeedPWM has changed
+#if defined(ENABLE_POWER_MANAGEMENT)
+uint8_t PWMDcMotor::SpeedPWMLimit = MAX_SPEED_PWM;
+#endif
 
 PWMDcMotor::PWMDcMotor() { // @suppress("Class members should be properly initialized")
 }
@@ -174,6 +177,9 @@ void PWMDcMotor::init(uint8_t aMotorNumber) {
 #  endif
 
     setDefaultsForFixedDistanceDriving();
+#if defined(ENABLE_DECAY_MODE_SELECTION)
+    DecayMode = DEFAULT_DECAY_MODE;
+#endif
     stop(STOP_MODE_KEEP);
 }
 
@@ -195,6 +201,9 @@ void PWMDcMotor::init(uint8_t aForwardPin, uint8_t aBackwardPin, uint8_t aPWMPin
     BackwardPin = aBackwardPin;
     PWMPin = aPWMPin;
     DefaultStopMode = DEFAULT_STOP_MODE;
+#if defined(ENABLE_DECAY_MODE_SELECTION)
+    DecayMode = DEFAULT_DECAY_MODE;
+#endif
 
     pinMode(aForwardPin, OUTPUT);
     pinMode(aBackwardPin, OUTPUT);
@@ -219,6 +228,16 @@ void PWMDcMotor::setDirection(uint8_t aMotorDirection) {
 }
 
 void PWMDcMotor::setMotorDriverMode(uint8_t aMotorDriverMode) {
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+    if (aMotorDriverMode == DIRECTION_FORWARD || aMotorDriverMode == DIRECTION_BACKWARD) {
+        if (LastDrivingDirection != aMotorDriverMode && LastDrivingDirection != DIRECTION_STOP && BacklashTakeUpMillis != 0) {
+            // Direction reversal -> next setSpeedPWM() starts the take up pulse
+            BacklashTakeUpStartMillis = millis();
+            BacklashTakeUpIsActive = true;
+        }
+        LastDrivingDirection = aMotorDriverMode;
+    }
+#endif
     CurrentDirection = aMotorDriverMode;
     if (aMotorDriverMode == STOP_MODE_RELEASE) {
         // We want to store only directions, no brake mode
@@ -269,7 +288,61 @@ void PWMDcMotor::setMotorDriverMode(uint8_t aMotorDriverMode) {
         break;
     }
 #endif // USE_ADAFRUIT_MOTOR_SHIELD
+#if defined(ENABLE_DECAY_MODE_SELECTION)
+    if (DecayMode != DECAY_MODE_OF_ENABLE_PIN_PWM) {
+        writeSpeedPWMToDirectionPins(CurrentCompensatedSpeedPWM); // Setting the direction pins above disabled their PWM
+    }
+#endif
+}
+
+#if defined(ENABLE_DECAY_MODE_SELECTION)
+/*
+ * The decay mode, which is not given by PWM at the enable pin, requires PWM capable direction pins.
+ * @param aDecayMode DECAY_MODE_SLOW or DECAY_MODE_FAST, see table at the definition of DECAY_MODE_SLOW
+ */
+void PWMDcMotor::setDecayMode(uint8_t aDecayMode) {
+    DecayMode = aDecayMode;
+    if (aDecayMode != DECAY_MODE_OF_ENABLE_PIN_PWM) {
+        // Enable pin is always active now
+#  if defined(USE_ADAFRUIT_MOTOR_SHIELD)
+        PCA9685SetPin(PWMPin, HIGH);
+#  else
+        digitalWrite(PWMPin, HIGH);
+#  endif
+    }
+    if (CurrentDirection == DIRECTION_FORWARD || CurrentDirection == DIRECTION_BACKWARD) {
+        setMotorDriverMode(CurrentDirection); // Restore static levels of the direction pins
+    }
+    writeSpeedPWM(CurrentCompensatedSpeedPWM);
+}
+
+/*
+ * Generates PWM at the active direction pin or inverted PWM at the other direction pin, while the enable pin is always active.
+ * Levels for stop modes are set by setMotorDriverMode().
+ */
+void PWMDcMotor::writeSpeedPWMToDirectionPins(uint8_t aCompensatedSpeedPWM) {
+    uint8_t tActivePin;
+    if (CurrentDirection == DIRECTION_FORWARD) {
+        tActivePin = ForwardPin;
+    } else if (CurrentDirection == DIRECTION_BACKWARD) {
+        tActivePin = BackwardPin;
+    } else {
+        return;
+    }
+#  if defined(USE_DRV8833_BRIDGE)
+    if (DecayMode == DECAY_MODE_SLOW) {
+        // Active pin stays high, other pin is high in the off phase -> both low side switches are on
+        tActivePin = ForwardPin ^ BackwardPin ^ tActivePin;
+        aCompensatedSpeedPWM = MAX_SPEED_PWM - aCompensatedSpeedPWM;
+    }
+#  endif
+#  if defined(USE_ADAFRUIT_MOTOR_SHIELD)
+    PCA9685SetPWM(tActivePin, 0, 16 * aCompensatedSpeedPWM);
+#  else
+    analogWrite(tActivePin, aCompensatedSpeedPWM);
+#  endif
 }
+#endif // defined(ENABLE_DECAY_MODE_SELECTION)
 
 uint8_t PWMDcMotor::getDirection() {
     return CurrentDirection;
@@ -306,6 +379,22 @@ void PWMDcMotor::setSpeedPWM(uint8_t aRequestedSpeedPWM) {
         stop(STOP_MODE_KEEP);
         return;
     }
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+    if (BacklashTakeUpIsActive) {
+        if (millis() - BacklashTakeUpStartMillis < BacklashTakeUpMillis) {
+            if (aRequestedSpeedPWM < BACKLASH_TAKE_UP_SPEED_PWM) {
+                aRequestedSpeedPWM = BACKLASH_TAKE_UP_SPEED_PWM; // Keep RequestedSpeedPWM to restore it by checkBacklashTakeUp()
+            }
+        } else {
+            BacklashTakeUpIsActive = false;
+        }
+    }
+#endif
+#if defined(ENABLE_POWER_MANAGEMENT)
+    if (aRequestedSpeedPWM > SpeedPWMLimit) {
+        aRequestedSpeedPWM = SpeedPWMLimit; // Keep RequestedSpeedPWM to restore it if limit is raised again
+    }
+#endif
     /*
      * Handle speed compensation
      */
@@ -325,19 +414,70 @@ void PWMDcMotor::setSpeedPWM(uint8_t aRequestedSpeedPWM) {
     if (CurrentCompensatedSpeedPWM != tCompensatedSpeedPWM) {
         CurrentCompensatedSpeedPWM = tCompensatedSpeedPWM;
         MotorPWMHasChanged = true;
-        /*
-         * Write to hardware
-         */
+        writeSpeedPWM(tCompensatedSpeedPWM);
+    }
+}
+
+/*
+ * Write PWM to hardware
+ * With USE_PHASE_SHIFTED_MOTOR_PWM, the B channel of an AVR timer runs in inverting mode with inverted compare value,
+ * so its pulse is at the end of the PWM period (fast PWM) or around TOP (phase correct PWM),
+ * while the pulse of the A channel is at the start of the period or around BOTTOM.
+ * For the Adafruit Motor Shield, the pulse of motor 2 starts at the half of the period.
+ * This reduces the peaks of the battery current and the voltage ripple at VIN, if both motors run with less than 50% PWM.
+ * The compare registers are double buffered by the hardware, so a new value becomes active at the next period.
+ */
+void PWMDcMotor::writeSpeedPWM(uint8_t aCompensatedSpeedPWM) {
+#if defined(ENABLE_DECAY_MODE_SELECTION)
+    if (DecayMode != DECAY_MODE_OF_ENABLE_PIN_PWM) {
+        writeSpeedPWMToDirectionPins(aCompensatedSpeedPWM);
+        return;
+    }
+#endif
 #if defined(USE_ADAFRUIT_MOTOR_SHIELD)
 #  if defined(_USE_OWN_LIBRARY_FOR_ADAFRUIT_MOTOR_SHIELD)
-        PCA9685SetPWM(PWMPin, 0, 16 * tCompensatedSpeedPWM);
+#    if defined(USE_PHASE_SHIFTED_MOTOR_PWM)
+    if (PWMPin == 13 && aCompensatedSpeedPWM != 0) {
+        // Motor 2, PCA9685 counter is 12 bit
+        PCA9685SetPWM(PWMPin, 2048, (2048 + (16 * aCompensatedSpeedPWM)) & 0x0FFF);
+        return;
+    }
+#    endif
+    PCA9685SetPWM(PWMPin, 0, 16 * aCompensatedSpeedPWM);
 #  else
-        Adafruit_MotorShield_DcMotor->setSpeedPWM(tCompensatedSpeedPWM);
+    Adafruit_MotorShield_DcMotor->setSpeedPWM(aCompensatedSpeedPWM);
 #  endif
 #else
-        analogWrite(PWMPin, tCompensatedSpeedPWM);
-#endif
+#  if defined(USE_PHASE_SHIFTED_MOTOR_PWM) && defined(TCCR0A)
+    if (aCompensatedSpeedPWM != 0 && aCompensatedSpeedPWM != 255) {
+        // 0 and 255 are handled by analogWrite() with digitalWrite(), which also disconnects the timer output
+        uint8_t tInvertedSpeedPWM = 255 - aCompensatedSpeedPWM;
+        switch (digitalPinToTimer(PWMPin)) {
+#    if defined(COM0B1)
+        case TIMER0B:
+            TCCR0A |= _BV(COM0B1) | _BV(COM0B0);
+            OCR0B = tInvertedSpeedPWM;
+            return;
+#    endif
+#    if defined(COM1B1)
+        case TIMER1B:
+            TCCR1A |= _BV(COM1B1) | _BV(COM1B0);
+            OCR1B = tInvertedSpeedPWM;
+            return;
+#    endif
+#    if defined(COM2B1)
+        case TIMER2B:
+            TCCR2A |= _BV(COM2B1) | _BV(COM2B0);
+            OCR2B = tInvertedSpeedPWM;
+            return;
+#    endif
+        default:
+            break;
+        }
     }
+#  endif
+    analogWrite(PWMPin, aCompensatedSpeedPWM);
+#endif
 }
 
 /*
@@ -384,6 +524,11 @@ void PWMDcMotor::setSpeedPWMAndDirection(uint8_t aRequestedSpeedPWM, uint8_t aRe
     } else {
         checkAndHandleDirectionChange(aRequestedDirection);
         setSpeedPWM(aRequestedSpeedPWM);
+#if !defined(DO_NOT_SUPPORT_RAMP)
+        if (MotorRampState == MOTOR_STATE_BLEND) {
+            MotorRampState = MOTOR_STATE_DRIVE; // direct setting ends blending
+        }
+#endif
     }
 }
 
@@ -435,6 +580,9 @@ bool PWMDcMotor::isStopped() {
  */
 void PWMDcMotor::stop(uint8_t aStopMode) {
     RequestedSpeedPWM = 0;
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+    BacklashTakeUpIsActive = false;
+#endif
     CurrentCompensatedSpeedPWM = 0;
     MotorPWMHasChanged = true;
     CheckStopConditionInUpdateMotor = false;
@@ -442,15 +590,7 @@ void PWMDcMotor::stop(uint8_t aStopMode) {
     MotorRampState = MOTOR_STATE_STOPPED;
 #endif
 
-#if defined(USE_ADAFRUIT_MOTOR_SHIELD)
-#  if defined(_USE_OWN_LIBRARY_FOR_ADAFRUIT_MOTOR_SHIELD)
-    PCA9685SetPWM(PWMPin, 0, 0);
-#  else
-    Adafruit_MotorShield_DcMotor->setSpeedPWM(0);
-#  endif
-#else
-    analogWrite(PWMPin, 0);
-#endif
+    writeSpeedPWM(0);
     if (aStopMode == STOP_MODE_KEEP) {
         aStopMode = DefaultStopMode;
     }
@@ -470,6 +610,30 @@ void PWMDcMotor::setStopMode(uint8_t aStopMode) {
     MotorControlValuesHaveChanged = true;
 }
 
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+/*
+ * Value can be determined by CarPWMMotorControl::calibrateBacklashWithIMU()
+ */
+void PWMDcMotor::setBacklashTakeUpMillis(uint8_t aBacklashTakeUpMillis) {
+    if (aBacklashTakeUpMillis > BACKLASH_MAX_TAKE_UP_MILLIS) {
+        aBacklashTakeUpMillis = BACKLASH_MAX_TAKE_UP_MILLIS;
+    }
+    BacklashTakeUpMillis = aBacklashTakeUpMillis;
+}
+
+/*
+ * Ends the take up pulse and restores RequestedSpeedPWM. Called by updateMotor().
+ */
+void PWMDcMotor::checkBacklashTakeUp() {
+    if (BacklashTakeUpIsActive && millis() - BacklashTakeUpStartMillis >= BacklashTakeUpMillis) {
+        BacklashTakeUpIsActive = false;
+        if (!isStopped()) {
+            setSpeedPWM(RequestedSpeedPWM);
+        }
+    }
+}
+#endif
+
 /*
  * Set DriveSpeedPWM, SpeedPWMCompensation and MillisPerCentimeter defaults
  * setDefaultsForFixedDistanceDriving() is called at init
@@ -481,6 +645,10 @@ void PWMDcMotor::setDefaultsForFixedDistanceDriving() {
     SpeedPWMCompensation = 0;
 #if !defined(USE_ENCODER_MOTOR_CONTROL)
     MillisPerCentimeter = DEFAULT_MILLIS_PER_CENTIMETER;
+#endif
+#if !defined(DO_NOT_SUPPORT_RAMP)
+    BlendAccelerationValueDelta = BLEND_ACCELERATION_VALUE_DELTA;
+    BlendDecelerationValueDelta = BLEND_DECELERATION_VALUE_DELTA;
 #endif
     MotorControlValuesHaveChanged = true;
 }
@@ -577,7 +745,13 @@ void PWMDcMotor::setSpeedPWMAndDirectionWithRamp(uint8_t aRequestedSpeedPWM, uin
         // Here ramp makes no sense, since requested PWM does not lead to spinning wheels
         setSpeedPWMAndDirection(aRequestedSpeedPWM, aRequestedDirection);
     } else {
-        if (MotorRampState == MOTOR_STATE_DRIVE && CurrentDirection == aRequestedDirection) {
+        if (MotorRampState == MOTOR_STATE_BLEND) {
+            /*
+             * Blending was started by setSpeedPWMAndDirectionSmooth() -> change drive speed without jump
+             */
+            setSpeedPWMAndDirectionSmooth(
+                    (aRequestedDirection == DIRECTION_BACKWARD) ? -(int) aRequestedSpeedPWM : (int) aRequestedSpeedPWM);
+        } else if (MotorRampState == MOTOR_STATE_DRIVE && CurrentDirection == aRequestedDirection) {
             /*
              * motor is running -> just change drive speed
              */
@@ -635,6 +809,21 @@ void PWMDcMotor::startRampDown() {
 #endif
 }
 
+/*
+ * Ramp up ends, if the PWM the motor gets is reached, which may be limited by SpeedPWMLimit.
+ * RequestedDriveSpeedPWM is not changed by the limit, to restore it if limit is raised again.
+ */
+#if !defined(DO_NOT_SUPPORT_RAMP)
+uint8_t PWMDcMotor::getRampEndSpeedPWM() {
+#  if defined(ENABLE_POWER_MANAGEMENT)
+    if (RequestedDriveSpeedPWM > SpeedPWMLimit) {
+        return SpeedPWMLimit;
+    }
+#  endif
+    return RequestedDriveSpeedPWM;
+}
+#endif
+
 /*
  * Guarantees, that both motors start ramp down at the same time
  */
@@ -651,11 +840,175 @@ void PWMDcMotor::synchronizeRampDown(PWMDcMotor *aOtherMotorControl) {
 #endif
 }
 
+/*
+ * Sets the target for speed blending, which is done by updateMotor().
+ * Speed changes at any time, also through zero, without stopping the motor first and without PWM jumps.
+ * @param aSignedRequestedSpeedPWM The 8-bit PWM value, 0 is off, 255 is on forward -255 is on backward
+ */
+void PWMDcMotor::setSpeedPWMAndDirectionSmooth(int aSignedRequestedSpeedPWM) {
+    if (aSignedRequestedSpeedPWM > MAX_SPEED_PWM) {
+        aSignedRequestedSpeedPWM = MAX_SPEED_PWM;
+    } else if (aSignedRequestedSpeedPWM < -MAX_SPEED_PWM) {
+        aSignedRequestedSpeedPWM = -MAX_SPEED_PWM;
+    }
+#if defined(DO_NOT_SUPPORT_RAMP)
+    setSpeedPWMAndDirection(aSignedRequestedSpeedPWM); // reduced to setSpeedPWMAndDirection()
+#else
+    BlendTargetSpeedPWM = aSignedRequestedSpeedPWM;
+    CheckStopConditionInUpdateMotor = false;
+    if (MotorRampState != MOTOR_STATE_BLEND) {
+        MotorRampState = MOTOR_STATE_BLEND;
+        NextRampChangeMillis = millis(); // First step at next updateMotor()
+    }
+#endif
+}
+
+/*
+ * @param aAccelerationValueDelta Max PWM increase per RAMP_INTERVAL_MILLIS
+ * @param aDecelerationValueDelta Max PWM decrease per RAMP_INTERVAL_MILLIS. Should be higher than acceleration value.
+ */
+void PWMDcMotor::setBlendAccelerationAndDeceleration(uint8_t aAccelerationValueDelta, uint8_t aDecelerationValueDelta) {
+#if !defined(DO_NOT_SUPPORT_RAMP)
+    BlendAccelerationValueDelta = aAccelerationValueDelta;
+    BlendDecelerationValueDelta = aDecelerationValueDelta;
+#else
+    (void) aAccelerationValueDelta;
+    (void) aDecelerationValueDelta;
+#endif
+}
+
+#if defined(ENABLE_POWER_MANAGEMENT)
+/*
+ * Called by CarPowerManager if SpeedPWMLimit has changed.
+ * Ramp and blend targets are kept unlimited, the limit is only applied at the output by setSpeedPWM().
+ * So setting RequestedSpeedPWM again restores the original speed if the limit is raised.
+ */
+void PWMDcMotor::applySpeedPWMLimit() {
+    if (!isStopped()) {
+        setSpeedPWM(RequestedSpeedPWM);
+    }
+}
+#endif
+
+/*
+ * Moves RequestedSpeedPWM and direction one step towards BlendTargetSpeedPWM every RAMP_INTERVAL_MILLIS.
+ * Start from standstill is done like ramp up with RAMP_UP_VALUE_OFFSET_SPEED_PWM,
+ * and speeds below RAMP_VALUE_MIN_SPEED_PWM are stopped immediately like at ramp down.
+ * At direction change the motor is braked for BLEND_DIRECTION_CHANGE_DWELL_MILLIS.
+ * Called by updateMotor() in MOTOR_STATE_BLEND.
+ * @return true if not stopped (motor expects another update)
+ */
+bool PWMDcMotor::updateSpeedBlending() {
+#if !defined(DO_NOT_SUPPORT_RAMP)
+    unsigned long tMillis = millis();
+    if (tMillis < NextRampChangeMillis) {
+        return true;
+    }
+    NextRampChangeMillis = tMillis + RAMP_INTERVAL_MILLIS;
+
+    uint8_t tTargetDirection = DIRECTION_FORWARD;
+    uint8_t tTargetSpeedPWM = BlendTargetSpeedPWM;
+    if (BlendTargetSpeedPWM < 0) {
+        tTargetDirection = DIRECTION_BACKWARD;
+        tTargetSpeedPWM = -BlendTargetSpeedPWM;
+    }
+
+    uint8_t tNewSpeedPWM = RequestedSpeedPWM;
+    if (tNewSpeedPWM == 0) {
+        /*
+         * Start from standstill, dwell time is over here
+         */
+        if (tTargetSpeedPWM == 0) {
+            MotorRampState = MOTOR_STATE_STOPPED;
+            return false;
+        }
+        setDirection(tTargetDirection); // this in turn sets CurrentDirection
+        tNewSpeedPWM = tTargetSpeedPWM;
+        if (tNewSpeedPWM > RAMP_UP_VALUE_OFFSET_SPEED_PWM) {
+            tNewSpeedPWM = RAMP_UP_VALUE_OFFSET_SPEED_PWM;
+        }
+
+    } else if (CurrentDirection == tTargetDirection && tTargetSpeedPWM >= tNewSpeedPWM) {
+        /*
+         * Accelerate
+         */
+        if (tTargetSpeedPWM - tNewSpeedPWM > BlendAccelerationValueDelta) {
+            tNewSpeedPWM += BlendAccelerationValueDelta;
+        } else {
+            tNewSpeedPWM = tTargetSpeedPWM;
+        }
+#  if defined(ENABLE_POWER_MANAGEMENT)
+        if (tNewSpeedPWM >= SpeedPWMLimit) {
+            tNewSpeedPWM = tTargetSpeedPWM; // The PWM the motor gets is reached
+        }
+#  endif
+
+    } else {
+        /*
+         * Decelerate to target speed or to zero for stop and direction change
+         */
+        uint8_t tMinimumSpeedPWM = 0;
+        if (CurrentDirection == tTargetDirection) {
+            tMinimumSpeedPWM = tTargetSpeedPWM;
+        }
+#  if defined(ENABLE_POWER_MANAGEMENT)
+        if (tNewSpeedPWM > SpeedPWMLimit) {
+            tNewSpeedPWM = SpeedPWMLimit; // Decelerate from the PWM the motor gets
+        }
+#  endif
+        if (tMinimumSpeedPWM == 0 && tNewSpeedPWM <= RAMP_VALUE_MIN_SPEED_PWM) {
+            tNewSpeedPWM = 0; // Motor can be stopped immediately
+        } else {
+            if (tNewSpeedPWM - tMinimumSpeedPWM > BlendDecelerationValueDelta) {
+                tNewSpeedPWM -= BlendDecelerationValueDelta;
+            } else {
+                tNewSpeedPWM = tMinimumSpeedPWM;
+            }
+            if (tMinimumSpeedPWM == 0 && tNewSpeedPWM < RAMP_VALUE_MIN_SPEED_PWM) {
+                // Clip at RAMP_VALUE_MIN_SPEED_PWM
+                tNewSpeedPWM = RAMP_VALUE_MIN_SPEED_PWM;
+            }
+        }
+    }
+
+#  if defined(TRACE)
+    Serial.print(PWMPin);
+    Serial.print(F(" Blend to "));
+    Serial.print(BlendTargetSpeedPWM);
+    Serial.print(F(" Ns="));
+    Serial.println(tNewSpeedPWM);
+#  endif
+    if (tNewSpeedPWM == 0) {
+        if (tTargetSpeedPWM == 0) {
+            stop(STOP_MODE_KEEP); // sets MOTOR_STATE_STOPPED
+            return false;
+        }
+        /*
+         * Direction change -> brake motor for dwell time
+         */
+        stop(STOP_MODE_BRAKE);
+        MotorRampState = MOTOR_STATE_BLEND;
+        NextRampChangeMillis = tMillis + BLEND_DIRECTION_CHANGE_DWELL_MILLIS;
+        return true;
+    }
+
+    PWMDcMotor::setSpeedPWM(tNewSpeedPWM);
+    if (tNewSpeedPWM == tTargetSpeedPWM && CurrentDirection == tTargetDirection) {
+        //  --> DRIVE
+        MotorRampState = MOTOR_STATE_DRIVE;
+    }
+#endif // !defined(DO_NOT_SUPPORT_RAMP)
+    return (RequestedSpeedPWM > 0);
+}
+
 #if !defined(USE_ENCODER_MOTOR_CONTROL)
 /*
  * @return true if not stopped (motor expects another update)
  */
 bool PWMDcMotor::updateMotor() {
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+    checkBacklashTakeUp();
+#endif
     uint8_t tNewSpeedPWM = RequestedSpeedPWM;
 
     /*
@@ -669,6 +1022,10 @@ bool PWMDcMotor::updateMotor() {
     }
 
 #if !defined(DO_NOT_SUPPORT_RAMP)
+    if (MotorRampState == MOTOR_STATE_BLEND) {
+        return updateSpeedBlending();
+    }
+
     unsigned long tMillis = millis();
 
     if (MotorRampState == MOTOR_STATE_START) {
@@ -700,7 +1057,7 @@ bool PWMDcMotor::updateMotor() {
              * Then check immediately for timeout
              */
             // Clip value and check for 8 bit overflow
-            if (tNewSpeedPWM >= RequestedDriveSpeedPWM || tNewSpeedPWM <= RAMP_UP_VALUE_DELTA) {
+            if (tNewSpeedPWM >= getRampEndSpeedPWM() || tNewSpeedPWM <= RAMP_UP_VALUE_DELTA) {
                 tNewSpeedPWM = RequestedDriveSpeedPWM;
                 //  --> DRIVE
                 MotorRampState = MOTOR_STATE_DRIVE;
@@ -999,6 +1356,12 @@ void PWMDcMotor::printCompileOptions(Print *aSerial) {
     aSerial->println(reinterpret_cast<const __FlashStringHelper*>(StringDefined));
 #endif
 
+    aSerial->print(F("USE_PHASE_SHIFTED_MOTOR_PWM:"));
+#if !defined(USE_PHASE_SHIFTED_MOTOR_PWM)
+    aSerial->print(reinterpret_cast<const __FlashStringHelper*>(StringNot));
+#endif
+    aSerial->println(reinterpret_cast<const __FlashStringHelper*>(StringDefined));
+
     aSerial->print(F("FULL_BRIDGE_OUTPUT_MILLIVOLT="));
     aSerial->print(FULL_BRIDGE_OUTPUT_MILLIVOLT);
     aSerial->println(